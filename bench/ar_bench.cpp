@@ -0,0 +1,444 @@
+// Microbenchmarks for the AR fitting and forecasting hot paths.
+//
+// Usage: ar_bench [--filter SUBSTR] [--max-n N] [--max-order P]
+//                 [--min-time SECONDS] [--json FILE]
+//
+// Each benchmark is timed Google-Benchmark style: the body is repeated until
+// it has run for at least --min-time, and ns/op, bytes/s and heap
+// allocations per op are reported. --json writes the same results in a
+// format compatible with Google Benchmark's JSON reporter, so runs can be
+// diffed across releases. Correctness checks live in tests/ (ar_tests).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "AREstimator.h"
+#include "ARModel.h"
+#include "Autocorrelation.h"
+#include "BatchFitter.h"
+#include "FixedARModel.h"
+#include "GpuBackend.h"
+#include "HorizonForecaster.h"
+#include "ModelCache.h"
+#include "ModelSnapshot.h"
+#include "MonteCarloForecaster.h"
+#include "SimdKernels.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include "VARModel.h"
+#include "WalkForwardBacktester.h"
+
+// ---------------------------------------------------------------------------
+// Allocation counting: every global operator new in this process bumps it.
+// ---------------------------------------------------------------------------
+
+static std::atomic<unsigned long long> g_allocations(0);
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    unsigned long long iterations;
+    double nsPerOp;
+    double bytesPerSecond;
+    double allocsPerOp;
+};
+
+struct BenchConfig {
+    std::string filter;
+    long long maxN = 1000000;
+    int maxOrder = 1000;
+    double minTime = 0.2;
+};
+
+// Prevent the optimizer from discarding benchmark results.
+volatile double g_sink = 0.0;
+
+// Run 'body' (one op per call) until minTime has elapsed; 'bytesPerOp' is the
+// data volume one op touches.
+BenchResult runBench(const std::string& name, const BenchConfig& cfg, double bytesPerOp,
+                     const std::function<void()>& body) {
+    typedef std::chrono::steady_clock Clock;
+    body(); // warm-up: caches, lazily-sized buffers, CPU dispatch
+
+    unsigned long long iters = 1;
+    for (;;) {
+        unsigned long long allocsBefore = g_allocations.load();
+        Clock::time_point t0 = Clock::now();
+        for (unsigned long long i = 0; i < iters; ++i) body();
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        unsigned long long allocs = g_allocations.load() - allocsBefore;
+
+        if (secs >= cfg.minTime || iters >= (1ull << 30)) {
+            BenchResult r;
+            r.name = name;
+            r.iterations = iters;
+            r.nsPerOp = secs * 1e9 / iters;
+            r.bytesPerSecond = bytesPerOp * iters / secs;
+            r.allocsPerOp = static_cast<double>(allocs) / iters;
+            return r;
+        }
+        // Aim a little past minTime, growing at most 10x per round.
+        double scale = secs > 0.0 ? 1.4 * cfg.minTime / secs : 10.0;
+        iters = static_cast<unsigned long long>(iters * std::min(10.0, std::max(2.0, scale)));
+    }
+}
+
+void printResult(const BenchResult& r) {
+    std::printf("%-44s %12llu %14.1f ns/op %10.3f GB/s %8.2f allocs/op\n",
+                r.name.c_str(), r.iterations, r.nsPerOp, r.bytesPerSecond / 1e9, r.allocsPerOp);
+    std::fflush(stdout);
+}
+
+void writeJson(const std::string& filename, const std::vector<BenchResult>& results) {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return;
+    }
+    out.precision(10);
+    out << "{\n  \"context\": {\n"
+        << "    \"executable\": \"ar_bench\",\n"
+        << "    \"simd_isa\": \"" << SimdKernels::isaName(SimdKernels::activeIsa()) << "\"\n"
+        << "  },\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"run_type\": \"iteration\""
+            << ", \"iterations\": " << r.iterations
+            << ", \"real_time\": " << r.nsPerOp
+            << ", \"time_unit\": \"ns\""
+            << ", \"bytes_per_second\": " << r.bytesPerSecond
+            << ", \"allocs_per_iter\": " << r.allocsPerOp << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+std::string label(const char* base, long long n, int order) {
+    std::string s = base;
+    if (n > 0) s += "/n:" + std::to_string(n);
+    if (order >= 0) s += "/p:" + std::to_string(order);
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    std::string jsonFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) cfg.filter = argv[++i];
+        else if (arg == "--max-n" && hasValue) cfg.maxN = std::atoll(argv[++i]);
+        else if (arg == "--max-order" && hasValue) cfg.maxOrder = std::atoi(argv[++i]);
+        else if (arg == "--min-time" && hasValue) cfg.minTime = std::atof(argv[++i]);
+        else if (arg == "--json" && hasValue) jsonFile = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter SUBSTR] [--max-n N] [--max-order P] [--min-time S] [--json FILE]\n";
+            return 1;
+        }
+    }
+
+    const long long sizes[] = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+    const int orders[] = {1, 10, 100, 1000};
+    const int forecastSteps = 1000;
+
+    std::vector<BenchResult> results;
+    auto run = [&](const std::string& name, double bytesPerOp, const std::function<void()>& body) {
+        if (!cfg.filter.empty() && name.find(cfg.filter) == std::string::npos) return;
+        results.push_back(runBench(name, cfg, bytesPerOp, body));
+        printResult(results.back());
+    };
+
+    std::printf("SIMD ISA: %s\n", SimdKernels::isaName(SimdKernels::activeIsa()));
+    std::printf("%-44s %12s %20s %15s %18s\n", "benchmark", "iterations", "time", "throughput", "allocations");
+
+    for (long long n : sizes) {
+        if (n > cfg.maxN) break;
+        std::vector<double> prices = SyntheticDataGenerator::generateGBM(
+            static_cast<int>(n + 1), 100.0, 0.01, 0.1, 1.0 / 252, 42);
+        std::vector<double> x = Transforms::difference(SeriesView(prices));
+        std::vector<float> xf(x.begin(), x.end());
+        const double bytes = static_cast<double>(n) * sizeof(double);
+
+        run(label("generateGBM", n, -1), bytes, [&] {
+            std::vector<double> p = SyntheticDataGenerator::generateGBM(static_cast<int>(n), 100.0, 0.01, 0.1, 1.0 / 252, 7);
+            g_sink = p.back();
+        });
+        std::vector<double> levels(n);
+        run(label("transform/difference", n, -1), bytes, [&] {
+            Transforms::difference(prices.data(), prices.size(), levels.data());
+            g_sink = levels[0];
+        });
+        run(label("transform/integrate", n, -1), bytes, [&] {
+            Transforms::integrate(x.data(), x.size(), &prices[0], levels.data());
+            g_sink = levels.back();
+        });
+
+        for (int p : orders) {
+            if (p > cfg.maxOrder || p >= n) continue;
+            std::vector<double> r;
+            run(label("computeAutocorrelation/direct", n, p), bytes, [&] {
+                Autocorrelation::compute(x.data(), x.size(), p, r, AutocorrelationMethod::Direct);
+                g_sink = r[0];
+            });
+            run(label("computeAutocorrelation/fft", n, p), bytes, [&] {
+                Autocorrelation::compute(x.data(), x.size(), p, r, AutocorrelationMethod::FFT);
+                g_sink = r[0];
+            });
+            run(label("computeAutocorrelation/auto", n, p), bytes, [&] {
+                Autocorrelation::compute(x.data(), x.size(), p, r, AutocorrelationMethod::Automatic);
+                g_sink = r[0];
+            });
+            run(label("computeAutocorrelation/direct/float", n, p), bytes / 2, [&] {
+                Autocorrelation::compute(xf.data(), xf.size(), p, r, AutocorrelationMethod::Direct);
+                g_sink = r[0];
+            });
+            run(label("computeCoefficients", n, p), bytes, [&] {
+                ARModel model(SeriesView(x), p);
+                model.computeCoefficients();
+                g_sink = model.getErrorVariance();
+            });
+            ARWorkspace ws(p);
+            ARModel wsModel(SeriesView(x), p);
+            run(label("computeCoefficients/workspace", n, p), bytes, [&] {
+                wsModel.computeCoefficients(ws);
+                g_sink = wsModel.getErrorVariance();
+            });
+            ModelCache cache;
+            run(label("computeCoefficients/cached", n, p), bytes, [&] {
+                cache.computeCoefficients(wsModel);
+                g_sink = wsModel.getErrorVariance();
+            });
+            FloatARModel floatModel(FloatSeriesView(xf), p);
+            run(label("computeCoefficients/workspace/float", n, p), bytes / 2, [&] {
+                floatModel.computeCoefficients(ws);
+                g_sink = floatModel.getErrorVariance();
+            });
+            // Whole order sweeps (AR(1)..AR(p)) per estimator.
+            YuleWalkerEstimator yuleWalker;
+            BurgEstimator burg;
+            ModifiedCovarianceEstimator covariance;
+            AREstimator* estimators[] = {&yuleWalker, &burg, &covariance};
+            LevinsonPath sweep;
+            for (AREstimator* estimator : estimators) {
+                run(label((std::string("fitAllOrders/") + estimator->name()).c_str(), n, p), bytes, [&] {
+                    wsModel.fitAllOrders(p, sweep, *estimator);
+                    g_sink = sweep.errorVariances[p];
+                });
+            }
+        }
+    }
+
+    // Order-only benchmarks use a fixed series long enough for every order.
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(10001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+    for (int p : orders) {
+        if (p > cfg.maxOrder) continue;
+        std::vector<double> r;
+        Autocorrelation::compute(x.data(), x.size(), p, r);
+        std::vector<double> coeffs;
+        const double coeffBytes = static_cast<double>(p) * sizeof(double);
+
+        run(label("levinsonDurbin", -1, p), coeffBytes, [&] {
+            ARModel::yuleWalker(r, p, coeffs);
+            g_sink = coeffs[0];
+        });
+        LevinsonPath path;
+        run(label("levinsonDurbin/allOrders", -1, p), coeffBytes * (p + 1) / 2, [&] {
+            ARModel::levinsonDurbin(r, p, path);
+            g_sink = path.errorVariances[p];
+        });
+
+        ARModel model(SeriesView(x), p);
+        model.computeCoefficients();
+        run(label("forwardPredict", -1, p), 2 * coeffBytes, [&] {
+            g_sink = model.forwardPredict();
+        });
+        SnapshotPublisher publisher;
+        publisher.publish(model);
+        SnapshotPublisher::Reader reader = publisher.registerReader();
+        run(label("forwardPredict/snapshot", -1, p), 2 * coeffBytes, [&] {
+            double y = 0.0;
+            reader.forwardPredict(x.data() + x.size() - p, y);
+            g_sink = y;
+        });
+        std::vector<double> out(forecastSteps);
+        run(label("forwardPredictSteps/k:1000", -1, p), 2 * coeffBytes * forecastSteps, [&] {
+            model.forwardPredictSteps(forecastSteps, out.data());
+            g_sink = out.back();
+        });
+        ARWorkspace ws(p);
+        run(label("forwardPredictSteps/workspace/k:1000", -1, p), 2 * coeffBytes * forecastSteps, [&] {
+            model.forwardPredictSteps(forecastSteps, out.data(), ws);
+            g_sink = out.back();
+        });
+        HorizonForecaster horizon(model);
+        run(label("horizonForecast/h:1000", -1, p), coeffBytes, [&] {
+            g_sink = horizon.forecast(x.data() + x.size() - p, forecastSteps).mean;
+        });
+        run(label("forwardPredictSteps/vector/k:1000", -1, p), 2 * coeffBytes * forecastSteps, [&] {
+            std::vector<double> v = model.forwardPredictSteps(forecastSteps);
+            g_sink = v.back();
+        });
+        if (p <= 100) {
+            // 10000 simulated paths of 100 steps, quantiles streamed per step.
+            MonteCarloForecaster monteCarlo(model);
+            MonteCarloOptions mc;
+            mc.paths = 10000;
+            mc.horizon = 100;
+            MonteCarloForecast dist;
+            run(label("monteCarlo/paths:10000/h:100", -1, p), 8.0 * mc.paths * mc.horizon, [&] {
+                monteCarlo.simulate(x.data() + x.size() - p, mc, dist);
+                g_sink = dist.quantiles.back();
+            });
+        }
+    }
+
+    // Walk-forward over the same series: sliding lag sums vs a refit from
+    // scratch at every origin.
+    WalkForwardBacktester backtester;
+    for (int p : orders) {
+        if (p > cfg.maxOrder || p >= 1000) continue;
+        WalkForwardOptions wf;
+        wf.order = p;
+        wf.window = 1000;
+        wf.horizon = 20;
+        const double bytes = static_cast<double>(x.size()) * sizeof(double);
+        run(label("walkForward/window:1000/h:20", -1, p), bytes, [&] {
+            g_sink = backtester.run(SeriesView(x), wf).overall.mse;
+        });
+        std::vector<double> f(wf.horizon);
+        run(label("walkForward/naive/window:1000/h:20", -1, p), bytes, [&] {
+            double sumSq = 0.0;
+            for (std::size_t t = wf.window; t + wf.horizon <= x.size(); ++t) {
+                ARModel model(SeriesView(x).slice(t - wf.window, wf.window), p);
+                if (!model.computeCoefficients() || !model.forwardPredictSteps(wf.horizon, f.data())) continue;
+                for (int j = 0; j < wf.horizon; ++j) sumSq += (f[j] - x[t + j]) * (f[j] - x[t + j]);
+            }
+            g_sink = sumSq;
+        });
+    }
+
+    // VAR fits over 8 aligned series (differenced GBM paths).
+    for (long long n : {10000LL, 100000LL, 1000000LL}) {
+        if (n > cfg.maxN) break;
+        const int dims = 8;
+        std::vector<double> levels = SyntheticDataGenerator::generateGBMPaths(
+            dims, static_cast<int>(n + 1), 100.0, 0.01, 0.1, 1.0 / 252, 42);
+        std::vector<double> columns(dims * n);
+        for (int c = 0; c < dims; ++c) {
+            Transforms::difference(levels.data() + c * (n + 1), n + 1, columns.data() + c * n);
+        }
+        const double bytes = static_cast<double>(dims) * n * sizeof(double);
+        for (int p : {1, 10}) {
+            if (p > cfg.maxOrder) continue;
+            VARModel var(columns.data(), n, dims, p);
+            run(label("varFit/dims:8", n, p), bytes, [&] {
+                var.computeCoefficients();
+                g_sink = var.getErrorCovariance()[0];
+            });
+            std::vector<double> f(forecastSteps * dims);
+            run(label("varForecastSteps/dims:8/k:1000", n, p), 2.0 * p * dims * dims * sizeof(double) * forecastSteps, [&] {
+                var.forwardPredictSteps(forecastSteps, f.data());
+                g_sink = f.back();
+            });
+        }
+    }
+
+    // Batch fits of 1000 series of 10^4 samples, on the pool and (when a
+    // device is usable) offloaded.
+    if (cfg.maxN >= 10000) {
+        const int series = 1000;
+        const long long n = 10000;
+        std::vector<double> levels = SyntheticDataGenerator::generateGBMPaths(
+            series, static_cast<int>(n + 1), 100.0, 0.01, 0.1, 1.0 / 252, 42);
+        std::vector<double> columns(series * n);
+        SeriesCollection collection;
+        for (int c = 0; c < series; ++c) {
+            Transforms::difference(levels.data() + c * (n + 1), n + 1, columns.data() + c * n);
+            collection.add(SeriesView(columns.data() + c * n, n));
+        }
+        const double bytes = static_cast<double>(series) * n * sizeof(double);
+        BatchFitter fitter;
+        for (int p : {10, 100}) {
+            if (p > cfg.maxOrder) continue;
+            run(label("batchFit/series:1000", n, p), bytes, [&] {
+                g_sink = fitter.fitBatch(collection, p).errorVariances[0];
+            });
+            if (GpuBackend::available()) {
+                fitter.setBackend(ComputeBackend::Cuda);
+                run(label("batchFit/cuda/series:1000", n, p), bytes, [&] {
+                    g_sink = fitter.fitBatch(collection, p).errorVariances[0];
+                });
+                fitter.setBackend(ComputeBackend::Cpu);
+            }
+        }
+    }
+
+    // Compile-time orders against the runtime-order model at the same order.
+    auto runFixed = [&](auto order) {
+        constexpr int p = decltype(order)::value;
+        if (p > cfg.maxOrder) return;
+        const double coeffBytes = static_cast<double>(p) * sizeof(double);
+        std::vector<double> r;
+        Autocorrelation::compute(x.data(), x.size(), p, r);
+        std::vector<double> coeffs;
+        typename FixedARModel<p>::Coefficients fixedCoeffs;
+        run(label("levinsonDurbin/dynamic", -1, p), coeffBytes, [&] {
+            ARModel::yuleWalker(r, p, coeffs);
+            g_sink = coeffs[0];
+        });
+        run(label("levinsonDurbin/fixed", -1, p), coeffBytes, [&] {
+            FixedARModel<p>::yuleWalker(r.data(), fixedCoeffs);
+            g_sink = fixedCoeffs[0];
+        });
+
+        ARModel model(SeriesView(x), p);
+        model.computeCoefficients();
+        FixedARModel<p> fixed{SeriesView(x)};
+        fixed.computeCoefficients();
+        std::vector<double> out(forecastSteps);
+        run(label("forwardPredict/dynamic", -1, p), 2 * coeffBytes, [&] {
+            g_sink = model.forwardPredict();
+        });
+        run(label("forwardPredict/fixed", -1, p), 2 * coeffBytes, [&] {
+            g_sink = fixed.forwardPredict();
+        });
+        run(label("forwardPredictSteps/dynamic/k:1000", -1, p), 2 * coeffBytes * forecastSteps, [&] {
+            model.forwardPredictSteps(forecastSteps, out.data());
+            g_sink = out.back();
+        });
+        run(label("forwardPredictSteps/fixed/k:1000", -1, p), 2 * coeffBytes * forecastSteps, [&] {
+            fixed.forwardPredictSteps(forecastSteps, out.data());
+            g_sink = out.back();
+        });
+    };
+    for (int p : {1, 2, 5, 10, 20}) {
+        withFixedOrder(p, runFixed);
+    }
+
+    if (!jsonFile.empty()) writeJson(jsonFile, results);
+    return 0;
+}
@@ -0,0 +1,505 @@
+// Accuracy and scaling harness: every fitting and forecasting engine against
+// the reference ARModel::computeCoefficients() / forwardPredictSteps().
+//
+// Usage: ar_harness [--max-n N] [--max-order P] [--max-threads T]
+//                   [--min-time SECONDS] [--json FILE] [--csv PREFIX]
+//
+// Accuracy: the corpus is differenced GBM paths from SyntheticDataGenerator
+// at each n in {10^3, 10^4, 10^5, 10^6} up to --max-n, fitted at orders
+// {1, 10, 50, 200} up to --max-order. For each engine it records
+//  - the coefficient delta, max_j |phi_j - phi_j(ref)|, and
+//  - the forecast delta, max_h |f_h - f_h(ref)| / rms(x) over 100 steps,
+// and fails when either exceeds the engine's stated tolerance (column
+// "tol" in the report). The process exits non-zero on any failure.
+//
+// Scaling: BatchFitter throughput (samples fitted per second) against the
+// thread count, both strong (a fixed corpus of 256 series) and weak (32
+// series per thread), and single-fit throughput of each engine against n.
+//
+// --json writes both tables in one document; --csv PREFIX writes
+// PREFIX.accuracy.csv and PREFIX.scaling.csv. The harness is a separate
+// executable and is not registered with ctest: the scaling half takes a
+// while and its numbers are machine-specific.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AREstimator.h"
+#include "ARModel.h"
+#include "BatchFitter.h"
+#include "FixedARModel.h"
+#include "GpuBackend.h"
+#include "HorizonForecaster.h"
+#include "ModelCache.h"
+#include "ModelSnapshot.h"
+#include "RingForecaster.h"
+#include "SimdKernels.h"
+#include "StreamingARModel.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+
+namespace {
+
+const int kForecastSteps = 100;
+const int kSeriesPerN = 4;
+
+struct Config {
+    long long maxN = 100000;
+    int maxOrder = 200;
+    int maxThreads = 0; // 0: hardware concurrency
+    double minTime = 0.2;
+};
+
+// One (series, order) case with its reference fit and forecast.
+struct Case {
+    SeriesView x;
+    int order;
+    std::vector<double> coefficients;
+    std::vector<double> forecast; // kForecastSteps
+    double rms;
+};
+
+// An engine yields coefficients and kForecastSteps forecasts for a case, or
+// false when it does not apply (e.g. FixedARModel at an uninstantiated order).
+struct Engine {
+    const char* name;
+    double coefficientTolerance;
+    double forecastTolerance;
+    std::function<bool(const Case&, std::vector<double>&, std::vector<double>&)> run;
+};
+
+struct AccuracyResult {
+    std::string engine;
+    std::size_t n;
+    int order;
+    double coefficientDelta;
+    double forecastDelta;
+    double coefficientTolerance;
+    double forecastTolerance;
+    bool pass;
+};
+
+struct ScalingResult {
+    std::string kind; // "strong", "weak" or "n"
+    std::string engine;
+    int threads;
+    std::size_t series;
+    std::size_t n;
+    double seconds;          // per run
+    double samplesPerSecond;
+    double speedup;          // vs 1 thread (strong), or 0
+    double efficiency;       // speedup / threads (strong), T1 / Tt (weak), or 0
+};
+
+// Forecasts from given coefficients and the case's last 'order' values.
+void ringForecast(const std::vector<double>& coefficients, SeriesView x, std::vector<double>& out) {
+    const int p = static_cast<int>(coefficients.size());
+    std::vector<double> reversed(coefficients.rbegin(), coefficients.rend());
+    RingForecaster f;
+    f.reset(reversed.data(), p, x.end() - p);
+    out.resize(kForecastSteps);
+    f.forecast(kForecastSteps, out.data());
+}
+
+template <int P>
+bool fixedFit(const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+    FixedARModel<P> model(c.x);
+    if (!model.computeCoefficients()) return false;
+    coeffs.assign(model.getCoefficients().begin(), model.getCoefficients().end());
+    forecast = model.forwardPredictSteps(kForecastSteps);
+    return true;
+}
+
+std::vector<Engine> engines() {
+    std::vector<Engine> list;
+    list.push_back({"ARModel/direct", 1e-9, 1e-9, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        ARModel model(c.x, c.order);
+        model.setAutocorrelationMethod(AutocorrelationMethod::Direct);
+        if (!model.computeCoefficients()) return false;
+        coeffs = model.getCoefficients();
+        forecast = model.forwardPredictSteps(kForecastSteps);
+        return true;
+    }});
+    list.push_back({"ARModel/fft", 1e-9, 1e-9, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        ARModel model(c.x, c.order);
+        model.setAutocorrelationMethod(AutocorrelationMethod::FFT);
+        if (!model.computeCoefficients()) return false;
+        coeffs = model.getCoefficients();
+        forecast = model.forwardPredictSteps(kForecastSteps);
+        return true;
+    }});
+    list.push_back({"ARModel/workspace", 0.0, 0.0, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        ARModel model(c.x, c.order);
+        ARWorkspace ws(c.order);
+        if (!model.computeCoefficients(ws)) return false;
+        coeffs = model.getCoefficients();
+        forecast.resize(kForecastSteps);
+        return model.forwardPredictSteps(kForecastSteps, forecast.data(), ws);
+    }});
+    list.push_back({"FloatARModel", 1e-7, 5e-7, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        std::vector<float> xf(c.x.begin(), c.x.end());
+        FloatARModel model(xf, c.order);
+        if (!model.computeCoefficients()) return false;
+        coeffs = model.getCoefficients();
+        forecast = model.forwardPredictSteps(kForecastSteps);
+        return true;
+    }});
+    list.push_back({"ModelCache", 1e-12, 1e-12, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        ModelCache cache;
+        ARModel model(c.x, c.order);
+        // The second call is served from the cache.
+        if (!cache.computeCoefficients(model) || !cache.computeCoefficients(model)) return false;
+        coeffs = model.getCoefficients();
+        forecast = model.forwardPredictSteps(kForecastSteps);
+        return true;
+    }});
+    list.push_back({"YuleWalkerEstimator", 1e-12, 1e-12, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        YuleWalkerEstimator estimator;
+        LevinsonPath path;
+        if (!estimator.fitPath(c.x, c.order, path)) return false;
+        coeffs.assign(path.coefficientsFor(c.order), path.coefficientsFor(c.order) + c.order);
+        ringForecast(coeffs, c.x, forecast);
+        return true;
+    }});
+    list.push_back({"StreamingARModel", 1e-8, 1e-8, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        StreamingARModel model = StreamingARModel::sliding(c.order, c.x.size());
+        for (double v : c.x) model.push(v);
+        if (!model.refit()) return false;
+        coeffs = model.getCoefficients();
+        forecast = model.forwardPredictSteps(kForecastSteps);
+        return true;
+    }});
+    list.push_back({"FixedARModel", 1e-12, 1e-12, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        switch (c.order) {
+        case 1: return fixedFit<1>(c, coeffs, forecast);
+        case 10: return fixedFit<10>(c, coeffs, forecast);
+        case 50: return fixedFit<50>(c, coeffs, forecast);
+        default: return false;
+        }
+    }});
+    list.push_back({"BatchFitter", 0.0, 0.0, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        static BatchFitter fitter;
+        SeriesCollection collection;
+        collection.add(c.x);
+        BatchFitResult r = fitter.fitBatch(collection, c.order);
+        if (!r.ok[0]) return false;
+        coeffs.assign(r.coefficientsFor(0), r.coefficientsFor(0) + c.order);
+        ringForecast(coeffs, c.x, forecast);
+        return true;
+    }});
+    if (GpuBackend::available()) {
+        list.push_back({"BatchFitter/cuda", 1e-9, 1e-9, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+            static BatchFitter fitter;
+            fitter.setBackend(ComputeBackend::Cuda);
+            SeriesCollection collection;
+            collection.add(c.x);
+            BatchFitResult r = fitter.fitBatch(collection, c.order);
+            if (!r.ok[0]) return false;
+            coeffs.assign(r.coefficientsFor(0), r.coefficientsFor(0) + c.order);
+            ringForecast(coeffs, c.x, forecast);
+            return true;
+        }});
+    }
+    // Forecast-only engines, fed the reference coefficients.
+    list.push_back({"HorizonForecaster", 0.0, 1e-9, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        HorizonForecaster horizon(c.coefficients, 1.0);
+        std::vector<int> horizons(kForecastSteps);
+        for (int h = 0; h < kForecastSteps; ++h) horizons[h] = h + 1;
+        std::vector<HorizonForecast> out(kForecastSteps);
+        if (!horizon.forecast(c.x.end() - c.order, horizons.data(), horizons.size(), out.data())) return false;
+        coeffs = c.coefficients;
+        forecast.resize(kForecastSteps);
+        for (int h = 0; h < kForecastSteps; ++h) forecast[h] = out[h].mean;
+        return true;
+    }});
+    list.push_back({"SnapshotPublisher", 0.0, 0.0, [](const Case& c, std::vector<double>& coeffs, std::vector<double>& forecast) {
+        SnapshotPublisher publisher;
+        publisher.publish(ModelSnapshot::fromCoefficients(c.coefficients, 1.0));
+        SnapshotPublisher::Reader reader = publisher.registerReader();
+        RingForecaster scratch;
+        forecast.resize(kForecastSteps);
+        if (!reader.forwardPredictSteps(c.x.end() - c.order, kForecastSteps, forecast.data(), scratch)) return false;
+        coeffs = c.coefficients;
+        return true;
+    }});
+    return list;
+}
+
+// Seconds per call of 'body', averaged over at least minTime.
+double timeIt(double minTime, const std::function<void()>& body) {
+    typedef std::chrono::steady_clock Clock;
+    body(); // warm-up
+    long long runs = 0;
+    Clock::time_point t0 = Clock::now();
+    double secs = 0.0;
+    do {
+        body();
+        ++runs;
+        secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    } while (secs < minTime);
+    return secs / runs;
+}
+
+// Differenced GBM paths, one row of n per series.
+std::vector<double> corpus(int series, std::size_t n, unsigned seed) {
+    std::vector<double> levels = SyntheticDataGenerator::generateGBMPaths(
+        series, static_cast<int>(n + 1), 100.0, 0.01, 0.1, 1.0 / 252, seed);
+    std::vector<double> x(series * n);
+    for (int s = 0; s < series; ++s) {
+        Transforms::difference(levels.data() + s * (n + 1), n + 1, x.data() + s * n);
+    }
+    return x;
+}
+
+SeriesCollection collectionOf(const std::vector<double>& x, std::size_t series, std::size_t n) {
+    SeriesCollection c;
+    for (std::size_t s = 0; s < series; ++s) c.add(SeriesView(x.data() + s * n, n));
+    return c;
+}
+
+// BatchFitter with exactly 'threads' participating threads.
+double batchSeconds(const Config& cfg, const SeriesCollection& collection, int order, int threads) {
+    BatchFitter fitter(threads);
+    return timeIt(cfg.minTime, [&] { fitter.fitBatch(collection, order); });
+}
+
+int runAccuracy(const Config& cfg, std::vector<AccuracyResult>& results) {
+    std::vector<Engine> list = engines();
+    int failures = 0;
+    std::printf("%-22s %9s %5s %12s %9s %12s %9s\n", "engine", "n", "p", "coef delta", "tol",
+                "fcst delta", "tol");
+    for (long long n : {1000LL, 10000LL, 100000LL, 1000000LL}) {
+        if (n > cfg.maxN) break;
+        std::vector<double> x = corpus(kSeriesPerN, n, 42);
+        for (int p : {1, 10, 50, 200}) {
+            if (p > cfg.maxOrder || 4 * p > n) continue;
+            std::vector<AccuracyResult> worst;
+            for (const Engine& e : list) {
+                worst.push_back(AccuracyResult {e.name, static_cast<std::size_t>(n), p, 0.0, 0.0,
+                                                e.coefficientTolerance, e.forecastTolerance, true});
+            }
+            bool applicable[64] = {};
+            for (int s = 0; s < kSeriesPerN; ++s) {
+                Case c {SeriesView(x.data() + s * n, n), p, {}, {}, 0.0};
+                ARModel reference(c.x, p);
+                if (!reference.computeCoefficients()) {
+                    ++failures;
+                    continue;
+                }
+                c.coefficients = reference.getCoefficients();
+                c.forecast = reference.forwardPredictSteps(kForecastSteps);
+                double sumSq = 0.0;
+                for (double v : c.x) sumSq += v * v;
+                c.rms = std::sqrt(sumSq / n);
+
+                std::vector<double> coeffs, forecast;
+                for (std::size_t i = 0; i < list.size(); ++i) {
+                    if (!list[i].run(c, coeffs, forecast)) continue;
+                    applicable[i] = true;
+                    AccuracyResult& r = worst[i];
+                    double dc = coeffs.size() == c.coefficients.size() ? 0.0 : INFINITY;
+                    for (std::size_t j = 0; j < coeffs.size() && j < c.coefficients.size(); ++j) {
+                        dc = std::max(dc, std::abs(coeffs[j] - c.coefficients[j]));
+                    }
+                    double df = forecast.size() == c.forecast.size() ? 0.0 : INFINITY;
+                    for (std::size_t h = 0; h < forecast.size() && h < c.forecast.size(); ++h) {
+                        df = std::max(df, std::abs(forecast[h] - c.forecast[h]) / c.rms);
+                    }
+                    // NaN deltas fail too.
+                    r.coefficientDelta = std::max(r.coefficientDelta, dc);
+                    r.forecastDelta = std::max(r.forecastDelta, df);
+                    r.pass = r.pass && dc <= r.coefficientTolerance && df <= r.forecastTolerance;
+                }
+            }
+            for (std::size_t i = 0; i < list.size(); ++i) {
+                if (!applicable[i]) continue;
+                const AccuracyResult& r = worst[i];
+                failures += r.pass ? 0 : 1;
+                std::printf("%-22s %9zu %5d %12.3g %9.0e %12.3g %9.0e  %s\n", r.engine.c_str(), r.n,
+                            r.order, r.coefficientDelta, r.coefficientTolerance, r.forecastDelta,
+                            r.forecastTolerance, r.pass ? "PASS" : "FAIL");
+                results.push_back(r);
+            }
+        }
+    }
+    return failures;
+}
+
+void runScaling(const Config& cfg, std::vector<ScalingResult>& results) {
+    const int order = 10;
+    const std::size_t n = static_cast<std::size_t>(std::min<long long>(cfg.maxN, 10000));
+    int maxThreads = cfg.maxThreads > 0 ? cfg.maxThreads
+                                        : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> threads;
+    for (int t = 1; t < maxThreads; t *= 2) threads.push_back(t);
+    threads.push_back(maxThreads);
+
+    std::printf("\n%-7s %-18s %7s %7s %9s %12s %14s %8s %8s\n", "kind", "engine", "threads", "series",
+                "n", "seconds", "samples/s", "speedup", "effic.");
+    auto report = [&](const ScalingResult& r) {
+        std::printf("%-7s %-18s %7d %7zu %9zu %12.4g %14.4g %8.3g %8.3g\n", r.kind.c_str(), r.engine.c_str(),
+                    r.threads, r.series, r.n, r.seconds, r.samplesPerSecond, r.speedup, r.efficiency);
+        results.push_back(r);
+    };
+
+    // Strong scaling: one fixed corpus, more threads.
+    const std::size_t strongSeries = 256;
+    std::vector<double> x = corpus(static_cast<int>(strongSeries), n, 7);
+    SeriesCollection strong = collectionOf(x, strongSeries, n);
+    double t1 = 0.0;
+    for (int t : threads) {
+        double secs = batchSeconds(cfg, strong, order, t);
+        if (t == 1) t1 = secs;
+        double speedup = t1 / secs;
+        report(ScalingResult {"strong", "BatchFitter", t, strongSeries, n, secs,
+                              strongSeries * n / secs, speedup, speedup / t});
+    }
+
+    // Weak scaling: a fixed share of the corpus per thread.
+    const std::size_t perThread = 32;
+    std::vector<double> wide = corpus(static_cast<int>(perThread * maxThreads), n, 7);
+    double w1 = 0.0;
+    for (int t : threads) {
+        const std::size_t series = perThread * t;
+        double secs = batchSeconds(cfg, collectionOf(wide, series, n), order, t);
+        if (t == 1) w1 = secs;
+        report(ScalingResult {"weak", "BatchFitter", t, series, n, secs, series * n / secs, 0.0, w1 / secs});
+    }
+
+    // Single fits against n, one thread.
+    for (long long len : {1000LL, 10000LL, 100000LL, 1000000LL}) {
+        if (len > cfg.maxN) break;
+        std::vector<double> s = corpus(1, len, 11);
+        std::vector<float> sf(s.begin(), s.end());
+        SeriesView view(s);
+        const std::size_t size = static_cast<std::size_t>(len);
+        auto fit = [&](const char* engine, const std::function<void()>& body) {
+            double secs = timeIt(cfg.minTime, body);
+            report(ScalingResult {"n", engine, 1, 1, size, secs, len / secs, 0.0, 0.0});
+        };
+        fit("ARModel", [&] {
+            ARModel m(view, order);
+            m.computeCoefficients();
+        });
+        fit("ARModel/fft", [&] {
+            ARModel m(view, order);
+            m.setAutocorrelationMethod(AutocorrelationMethod::FFT);
+            m.computeCoefficients();
+        });
+        fit("FloatARModel", [&] {
+            FloatARModel m(FloatSeriesView(sf.data(), sf.size()), order);
+            m.computeCoefficients();
+        });
+        fit("FixedARModel", [&] {
+            FixedARModel<10> m(view);
+            m.computeCoefficients();
+        });
+        fit("StreamingARModel", [&] {
+            StreamingARModel m = StreamingARModel::sliding(order, size);
+            for (double v : s) m.push(v);
+            m.refit();
+        });
+    }
+}
+
+void writeJson(const std::string& filename, const std::vector<AccuracyResult>& accuracy,
+               const std::vector<ScalingResult>& scaling) {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return;
+    }
+    out.precision(10);
+    out << "{\n  \"context\": {\n"
+        << "    \"executable\": \"ar_harness\",\n"
+        << "    \"simd_isa\": \"" << SimdKernels::isaName(SimdKernels::activeIsa()) << "\",\n"
+        << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"forecast_steps\": " << kForecastSteps << "\n"
+        << "  },\n  \"accuracy\": [\n";
+    for (std::size_t i = 0; i < accuracy.size(); ++i) {
+        const AccuracyResult& r = accuracy[i];
+        out << "    {\"engine\": \"" << r.engine << "\", \"n\": " << r.n << ", \"order\": " << r.order
+            << ", \"coefficient_delta\": " << r.coefficientDelta
+            << ", \"coefficient_tolerance\": " << r.coefficientTolerance
+            << ", \"forecast_delta\": " << r.forecastDelta
+            << ", \"forecast_tolerance\": " << r.forecastTolerance
+            << ", \"pass\": " << (r.pass ? "true" : "false") << "}"
+            << (i + 1 < accuracy.size() ? ",\n" : "\n");
+    }
+    out << "  ],\n  \"scaling\": [\n";
+    for (std::size_t i = 0; i < scaling.size(); ++i) {
+        const ScalingResult& r = scaling[i];
+        out << "    {\"kind\": \"" << r.kind << "\", \"engine\": \"" << r.engine << "\""
+            << ", \"threads\": " << r.threads << ", \"series\": " << r.series << ", \"n\": " << r.n
+            << ", \"seconds\": " << r.seconds << ", \"samples_per_second\": " << r.samplesPerSecond
+            << ", \"speedup\": " << r.speedup << ", \"efficiency\": " << r.efficiency << "}"
+            << (i + 1 < scaling.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+void writeCsv(const std::string& prefix, const std::vector<AccuracyResult>& accuracy,
+              const std::vector<ScalingResult>& scaling) {
+    std::ofstream acc(prefix + ".accuracy.csv");
+    std::ofstream sc(prefix + ".scaling.csv");
+    if (!acc || !sc) {
+        std::cerr << "Error opening " << prefix << ".*.csv for writing.\n";
+        return;
+    }
+    acc.precision(10);
+    sc.precision(10);
+    acc << "engine,n,order,coefficient_delta,coefficient_tolerance,forecast_delta,forecast_tolerance,pass\n";
+    for (const AccuracyResult& r : accuracy) {
+        acc << r.engine << ',' << r.n << ',' << r.order << ',' << r.coefficientDelta << ','
+            << r.coefficientTolerance << ',' << r.forecastDelta << ',' << r.forecastTolerance << ','
+            << (r.pass ? 1 : 0) << '\n';
+    }
+    sc << "kind,engine,threads,series,n,seconds,samples_per_second,speedup,efficiency\n";
+    for (const ScalingResult& r : scaling) {
+        sc << r.kind << ',' << r.engine << ',' << r.threads << ',' << r.series << ',' << r.n << ','
+           << r.seconds << ',' << r.samplesPerSecond << ',' << r.speedup << ',' << r.efficiency << '\n';
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    std::string jsonFile, csvPrefix;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--max-n" && hasValue) cfg.maxN = std::atoll(argv[++i]);
+        else if (arg == "--max-order" && hasValue) cfg.maxOrder = std::atoi(argv[++i]);
+        else if (arg == "--max-threads" && hasValue) cfg.maxThreads = std::atoi(argv[++i]);
+        else if (arg == "--min-time" && hasValue) cfg.minTime = std::atof(argv[++i]);
+        else if (arg == "--json" && hasValue) jsonFile = argv[++i];
+        else if (arg == "--csv" && hasValue) csvPrefix = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--max-n N] [--max-order P] [--max-threads T] [--min-time S]"
+                      << " [--json FILE] [--csv PREFIX]\n";
+            return 1;
+        }
+    }
+
+    std::printf("SIMD ISA: %s, CUDA: %s\n\n", SimdKernels::isaName(SimdKernels::activeIsa()),
+                GpuBackend::available() ? GpuBackend::deviceName().c_str() : "unavailable");
+    std::vector<AccuracyResult> accuracy;
+    std::vector<ScalingResult> scaling;
+    int failures = runAccuracy(cfg, accuracy);
+    runScaling(cfg, scaling);
+
+    if (!jsonFile.empty()) writeJson(jsonFile, accuracy, scaling);
+    if (!csvPrefix.empty()) writeCsv(csvPrefix, accuracy, scaling);
+    std::printf("\n%d accuracy check%s failed.\n", failures, failures == 1 ? "" : "s");
+    return failures == 0 ? 0 : 1;
+}
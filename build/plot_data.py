@@ -1,3 +1,4 @@
+import csv
 import os
 import numpy as np
 import matplotlib.pyplot as plt
@@ -5,10 +6,74 @@ from matplotlib.animation import FuncAnimation
 
 # --- Helper Functions ---
 def read_vector(filename):
-    """Read a text file containing one float per line and return as a list of floats."""
+    """Read a vector written by the C++ side and return it as a list of floats.
+
+    Looks in the run container named by $AR_ARTIFACTS (written with --output)
+    first, then prefers the binary series file (same name with a .bin
+    extension, written with --binary) and falls back to the text file with
+    one float per line.
+    """
+    key = os.path.splitext(filename)[0]
+    if ARTIFACTS is not None and key in ARTIFACTS:
+        return list(ARTIFACTS[key])
+    bin_name = os.path.splitext(filename)[0] + ".bin"
+    if os.path.exists(bin_name):
+        return read_binary_series(bin_name).tolist()
     with open(filename, 'r') as f:
         return [float(line.strip()) for line in f if line.strip()]
 
+def has_vector(filename):
+    """True if read_vector(filename) would find the artifact."""
+    key = os.path.splitext(filename)[0]
+    if ARTIFACTS is not None:
+        return key in ARTIFACTS
+    return os.path.exists(key + ".bin") or os.path.exists(filename)
+
+def read_binary_series(filename):
+    """Memory-map a binary series file (32-byte 'ARSB' header + float64 samples)."""
+    header = np.fromfile(filename, dtype=np.uint8, count=32)
+    if bytes(header[:4]) != b"ARSB":
+        raise ValueError(f"{filename} is not a binary series file")
+    length = int(header[16:24].view("<u8")[0])
+    return np.memmap(filename, dtype="<f8", mode="r", offset=32, shape=(length,))
+
+def read_container(filename):
+    """Read an artifact container (.arc, or .csv with key,index,value rows) into a dict."""
+    artifacts = {}
+    if filename.endswith(".csv"):
+        # Same rules as ArtifactWriter::read(): keys are RFC 4180 quoted (and
+        # may hold commas, quotes or line breaks), "key,," is an empty series,
+        # "key,,value" a scalar, and consecutive rows with one key form a series.
+        with open(filename, 'r', newline='') as f:
+            rows = csv.reader(f)
+            next(rows, None)
+            previous = None
+            for row in rows:
+                if len(row) != 3:
+                    raise ValueError(f"malformed artifact row in {filename}: {row}")
+                key, index, value = row
+                if key != previous or (index == "" and value == ""):
+                    artifacts[key] = []
+                    previous = key
+                if value != "":
+                    artifacts[key].append(float(value))
+        return artifacts
+    data = np.fromfile(filename, dtype=np.uint8)
+    if bytes(data[:4]) != b"ARCN":
+        raise ValueError(f"{filename} is not an artifact container")
+    pos = 32
+    while pos + 16 <= len(data):
+        key_bytes = int(data[pos:pos + 4].view("<u4")[0])
+        length = int(data[pos + 8:pos + 16].view("<u8")[0])
+        pos += 16
+        key = bytes(data[pos:pos + key_bytes]).split(b"\0")[0].decode()
+        pos += key_bytes
+        artifacts[key] = data[pos:pos + 8 * length].view("<f8")
+        pos += 8 * length
+    return artifacts
+
+ARTIFACTS = read_container(os.environ["AR_ARTIFACTS"]) if "AR_ARTIFACTS" in os.environ else None
+
 def read_csv(filename):
     """Read a CSV file (header + numeric rows) and return a dict of lists."""
     data = {}
@@ -29,6 +94,10 @@ def plot_error_metrics():
         os.makedirs(plots_dir)
 
     orders = [int(x) for x in read_vector("ar_orders.txt")]
+    if not has_vector("ar_mses.txt"):
+        # --select aic|bic|hqic without --mse-curve: no validation errors.
+        plot_criteria(orders)
+        return
     mses = read_vector("ar_mses.txt")
     rmses = read_vector("ar_rmses.txt")
     mapes = read_vector("ar_mapes.txt")
@@ -65,6 +134,22 @@ def plot_error_metrics():
 
     print("Error metric plots saved in 'plots' folder.")
 
+# --- Plot Information Criteria vs AR Order ---
+def plot_criteria(orders):
+    plots_dir = "plots"
+    plt.figure(figsize=(8,5))
+    for name, style in (("aic", "bo-"), ("bic", "ro-"), ("hqic", "go-")):
+        if has_vector(f"ar_{name}.txt"):
+            plt.plot(orders, read_vector(f"ar_{name}.txt"), style, label=name.upper())
+    plt.xlabel("AR Order")
+    plt.ylabel("Criterion")
+    plt.title("Information Criteria vs. AR Order")
+    plt.legend()
+    plt.grid(True)
+    plt.savefig(os.path.join(plots_dir, "criteria_vs_ar_order.png"))
+    plt.close()
+    print("No validation errors in this run (criterion selection); criteria plot saved in 'plots' folder.")
+
 # --- Plot AR Coefficients ---
 def plot_ar_coefficients():
     plots_dir = "plots"
@@ -0,0 +1,276 @@
+#include "AREstimator.h"
+#include "SimdKernels.h"
+#include "Trace.h"
+#include <iostream>
+
+namespace {
+
+bool enoughData(std::size_t n, int maxOrder) {
+    if (maxOrder < 1 || n <= static_cast<std::size_t>(maxOrder)) {
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
+    }
+    return true;
+}
+
+void resetPath(LevinsonPath& path, int maxOrder) {
+    path.maxOrder = 0;
+    path.coefficients.assign(static_cast<std::size_t>(maxOrder) * (maxOrder + 1) / 2, 0.0);
+    path.errorVariances.assign(maxOrder + 1, 0.0);
+    path.reflectionCoefficients.assign(maxOrder + 1, 0.0);
+}
+
+// AR(m) coefficients from AR(m-1) and the reflection coefficient lambda:
+// phi_j -= lambda * phi_(m-j), phi_m = lambda.
+void levinsonStep(LevinsonPath& path, int m, double lambda) {
+    double* a = path.coefficients.data() + static_cast<std::size_t>(m) * (m - 1) / 2;
+    if (m > 1) {
+        const double* prev = path.coefficientsFor(m - 1);
+        for (int j = 0; j < m - 1; ++j) {
+            a[j] = prev[j] - lambda * prev[m - 2 - j];
+        }
+    }
+    a[m - 1] = lambda;
+    path.reflectionCoefficients[m] = lambda;
+}
+
+} // namespace
+
+std::unique_ptr<AREstimator> AREstimator::create(const std::string& name) {
+    if (name == "yule-walker") return std::unique_ptr<AREstimator>(new YuleWalkerEstimator());
+    if (name == "burg") return std::unique_ptr<AREstimator>(new BurgEstimator());
+    if (name == "covariance") return std::unique_ptr<AREstimator>(new ModifiedCovarianceEstimator());
+    return std::unique_ptr<AREstimator>();
+}
+
+// ---------------------------------------------------------------------------
+// Yule-Walker
+
+template <class T>
+bool YuleWalkerEstimator::fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path) {
+    if (maxOrder < 1 || data.size() < static_cast<std::size_t>(maxOrder)) {
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
+    }
+    Autocorrelation::compute(data.data(), data.size(), maxOrder, r_, method_, &acf_);
+    return ARModel::levinsonDurbin(r_, maxOrder, path);
+}
+
+bool YuleWalkerEstimator::fitPath(SeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
+
+bool YuleWalkerEstimator::fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
+
+// ---------------------------------------------------------------------------
+// Burg
+
+template <class T>
+bool BurgEstimator::fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path) {
+    AR_TRACE_SCOPE("burg");
+    const std::size_t n = data.size();
+    if (!enoughData(n, maxOrder)) return false;
+    resetPath(path, maxOrder);
+
+    forward_.assign(data.begin(), data.end());
+    backward_.assign(data.begin(), data.end());
+    double energy = 0.0;
+    for (double v : backward_) energy += v * v;
+    if (energy == 0.0) {
+        std::cerr << "Zero-energy series. Cannot compute coefficients.\n";
+        return false;
+    }
+    path.errorVariances[0] = energy / n;
+
+    // At order m, f[j] is the forward error at t = m + j and b[j] the
+    // backward error at t = m + j - 1, j < len = n - m. Both update in place;
+    // the next order pairs f[j + 1] with b[j], so only 'f' moves.
+    double* f = forward_.data() + 1;
+    double* b = backward_.data();
+    std::size_t len = n - 1;
+    double den = SimdKernels::dot(f, f, len) + SimdKernels::dot(b, b, len);
+    for (int m = 1; m <= maxOrder; ++m) {
+        const double num = SimdKernels::dot(f, b, len);
+        const double lambda = den > 0.0 ? 2.0 * num / den : 0.0;
+        levinsonStep(path, m, lambda);
+        path.errorVariances[m] = path.errorVariances[m - 1] * (1.0 - lambda * lambda);
+        if (m == maxOrder) break;
+
+        for (std::size_t j = 0; j < len; ++j) {
+            const double fj = f[j], bj = b[j];
+            f[j] = fj - lambda * bj;
+            b[j] = bj - lambda * fj;
+        }
+        // The updated errors have energy (1 + lambda^2) den - 4 lambda num;
+        // the next order drops f[0] and b[len - 1] (Andersen's recursion).
+        den = (1.0 + lambda * lambda) * den - 4.0 * lambda * num - f[0] * f[0] - b[len - 1] * b[len - 1];
+        ++f;
+        --len;
+    }
+    path.maxOrder = maxOrder;
+    return true;
+}
+
+bool BurgEstimator::fitPath(SeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
+
+bool BurgEstimator::fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
+
+// ---------------------------------------------------------------------------
+// Modified covariance
+//
+// With rows u_t = [x[t], x[t-1], ..., x[t-k]], the order-k normal matrix is
+//   R_k = sum_{t=k}^{n-1} (u_t u_t^T + J u_t u_t^T J)
+// (J reverses a vector), and the AR(k) polynomial is R_k^-1 e_0 normalized
+// to a leading 1. R_k is symmetric and persymmetric, so R_k^-1 J = J R_k^-1.
+//
+// The leading (k+1) x (k+1) block of R_(k+1) is M = R_k - u u^T - v v^T with
+// u = u_k, the first forward row, and v = J u_(n-1), the last backward row,
+// and its trailing block is J M J. So, per order:
+//   1. M^-1 e_0 (= f), M^-1 J u and M^-1 J v follow from the kept solves
+//      a = R_k^-1 e_0, pu = R_k^-1 u and pv = R_k^-1 v by the Woodbury
+//      identity for the rank-2 downdate.
+//   2. R_(k+1) [f; 0] = [1, 0, ..., 0, gamma]^T and, by persymmetry,
+//      R_(k+1) [0; J f] = [gamma, 0, ..., 0, 1]^T, so a Levinson-style step
+//      gives R_(k+1)^-1 e_0 = ([f; 0] - gamma [0; J f]) / (1 - gamma^2).
+//   3. R_(k+1)^-1 [s; w] = [0; J M^-1 J w] + (s - q^T J M^-1 J w) R_(k+1)^-1 e_0
+//      (q: first column of R_(k+1) below the diagonal) yields the new pu and
+//      pv, since u_(k+1) = [x[k+1]; u_k] and v_(k+1) = [x[n-k-2]; v_k].
+// Only the first column of R_(k+1) is needed, and it follows from the raw lag
+// sums by removing one edge product per entry per order.
+
+template <class T>
+bool ModifiedCovarianceEstimator::fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path) {
+    AR_TRACE_SCOPE("modified_covariance");
+    const std::size_t n = data.size();
+    if (!enoughData(n, maxOrder)) return false;
+    if (2 * (n - maxOrder) <= static_cast<std::size_t>(maxOrder)) {
+        std::cerr << "Not enough data for a covariance-method AR(" << maxOrder << ") fit.\n";
+        return false;
+    }
+    resetPath(path, maxOrder);
+    const T* x = data.data();
+    const std::size_t size = static_cast<std::size_t>(maxOrder) + 2;
+
+    lags_.resize(maxOrder + 1);
+    SimdKernels::lagProducts(x, n, maxOrder, lags_.data());
+    if (lags_[0] == 0.0) {
+        std::cerr << "Zero-energy series. Cannot compute coefficients.\n";
+        return false;
+    }
+    fwdColumn_.assign(size, 0.0);
+    bwdColumn_.assign(size, 0.0);
+    column_.assign(size, 0.0);
+    a_.assign(size, 0.0);
+    pu_.assign(size, 0.0);
+    pv_.assign(size, 0.0);
+    f_.assign(size, 0.0);
+    gu_.assign(size, 0.0);
+    gv_.assign(size, 0.0);
+
+    // Order 0: R_0 = 2 * sum x^2.
+    fwdColumn_[0] = bwdColumn_[0] = lags_[0];
+    const double r0 = 2.0 * lags_[0];
+    a_[0] = 1.0 / r0;
+    pu_[0] = x[0] / r0;
+    pv_[0] = x[n - 1] / r0;
+    path.errorVariances[0] = lags_[0] / n;
+
+    for (int k = 0; k < maxOrder; ++k) {
+        const std::size_t last = n - 1 - k; // v_k starts at x[last]
+
+        // First column of R_(k+1): drop row t = k from the forward sums and
+        // row t = n-1-k from the backward sums; the new entry is a raw lag sum.
+        for (int j = 0; j <= k; ++j) {
+            fwdColumn_[j] -= static_cast<double>(x[k - j]) * x[k];
+            bwdColumn_[j] -= static_cast<double>(x[last]) * x[last + j];
+            column_[j] = fwdColumn_[j] + bwdColumn_[j];
+        }
+        fwdColumn_[k + 1] = bwdColumn_[k + 1] = lags_[k + 1];
+        column_[k + 1] = 2.0 * lags_[k + 1];
+
+        // Woodbury: M^-1 = R^-1 + [pu pv] (I - G)^-1 [pu pv]^T,
+        // G = [u v]^T R^-1 [u v].
+        double uu = 0.0, uv = 0.0, vv = 0.0;
+        double ua = 0.0, va = 0.0;
+        double uJu = 0.0, vJu = 0.0, uJv = 0.0, vJv = 0.0;
+        for (int i = 0; i <= k; ++i) {
+            const double ui = x[k - i], vi = x[last + i];
+            uu += ui * pu_[i];
+            uv += ui * pv_[i];
+            vv += vi * pv_[i];
+            ua += ui * a_[i];
+            va += vi * a_[i];
+            uJu += ui * pu_[k - i];
+            vJu += vi * pu_[k - i];
+            uJv += ui * pv_[k - i];
+            vJv += vi * pv_[k - i];
+        }
+        const double d11 = 1.0 - uu, d22 = 1.0 - vv;
+        const double det = d11 * d22 - uv * uv;
+        if (!(det > 0.0)) {
+            std::cerr << "Covariance-method normal equations are singular at order " << (k + 1) << ".\n";
+            return false;
+        }
+        const double h11 = d22 / det, h12 = uv / det, h22 = d11 / det;
+        const double fu = h11 * ua + h12 * va, fv = h12 * ua + h22 * va;
+        const double guu = h11 * uJu + h12 * vJu, guv = h12 * uJu + h22 * vJu;
+        const double gvu = h11 * uJv + h12 * vJv, gvv = h12 * uJv + h22 * vJv;
+        double gamma = 0.0;
+        for (int i = 0; i <= k; ++i) {
+            f_[i] = a_[i] + pu_[i] * fu + pv_[i] * fv;
+            gu_[i] = pu_[k - i] + pu_[i] * guu + pv_[i] * guv;
+            gv_[i] = pv_[k - i] + pu_[i] * gvu + pv_[i] * gvv;
+            gamma += column_[k + 1 - i] * f_[i];
+        }
+        const double scale = 1.0 - gamma * gamma;
+        if (!(f_[0] > 0.0) || !(scale > 0.0)) {
+            std::cerr << "Covariance-method normal equations are singular at order " << (k + 1) << ".\n";
+            return false;
+        }
+
+        // a' = ([f; 0] - gamma [0; J f]) / (1 - gamma^2).
+        a_[0] = f_[0] / scale;
+        for (int i = 1; i <= k; ++i) {
+            a_[i] = (f_[i] - gamma * f_[k + 1 - i]) / scale;
+        }
+        a_[k + 1] = -gamma * f_[0] / scale;
+
+        // pu' and pv' from z = J M^-1 J w, i.e. z[j] = g[k - j].
+        double qu = 0.0, qv = 0.0;
+        for (int j = 0; j <= k; ++j) {
+            qu += column_[j + 1] * gu_[k - j];
+            qv += column_[j + 1] * gv_[k - j];
+        }
+        const double cu = x[k + 1] - qu, cv = x[last - 1] - qv;
+        pu_[0] = cu * a_[0];
+        pv_[0] = cv * a_[0];
+        for (int i = 1; i <= k + 1; ++i) {
+            pu_[i] = gu_[k + 1 - i] + cu * a_[i];
+            pv_[i] = gv_[k + 1 - i] + cv * a_[i];
+        }
+
+        const int m = k + 1;
+        double* coeffs = path.coefficients.data() + static_cast<std::size_t>(m) * (m - 1) / 2;
+        for (int j = 1; j <= m; ++j) {
+            coeffs[j - 1] = -a_[j] / a_[0];
+        }
+        path.reflectionCoefficients[m] = coeffs[m - 1];
+        path.errorVariances[m] = 1.0 / (a_[0] * 2.0 * (n - m));
+    }
+    path.maxOrder = maxOrder;
+    return true;
+}
+
+bool ModifiedCovarianceEstimator::fitPath(SeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
+
+bool ModifiedCovarianceEstimator::fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) {
+    return fit(data, maxOrder, path);
+}
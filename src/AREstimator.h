@@ -0,0 +1,107 @@
+#ifndef AR_ESTIMATOR_H
+#define AR_ESTIMATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ARModel.h"
+#include "Autocorrelation.h"
+#include "SeriesView.h"
+
+// Order-recursive AR estimator: one pass over a series yields the AR(k)
+// solution for every k = 1..maxOrder, stored as a LevinsonPath so that
+// ARModel::selectOrder() and OrderSelector take it unchanged.
+//
+// Conventions follow the Yule-Walker path: coefficients are phi_1..phi_k for
+// x[t] = sum_j phi_j x[t-j], reflectionCoefficients[k] is phi_k of the AR(k)
+// fit, and errorVariances[k] is a per-sample innovation variance. Series are
+// used as given (no mean removal).
+//
+// Estimators keep their scratch buffers between calls, so repeated fits of
+// the same size do not allocate. An estimator must not be used by two
+// threads at once; use one per thread.
+class AREstimator {
+public:
+    virtual ~AREstimator() {}
+
+    virtual const char* name() const = 0;
+
+    virtual bool fitPath(SeriesView data, int maxOrder, LevinsonPath& path) = 0;
+    virtual bool fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) = 0;
+
+    // "yule-walker", "burg" or "covariance"; null for an unknown name.
+    static std::unique_ptr<AREstimator> create(const std::string& name);
+};
+
+// Biased autocorrelation + Levinson-Durbin: the same path as
+// ARModel::fitAllOrders(). O(n * P) for the autocorrelation (or FFT), O(P^2)
+// for the recursion.
+class YuleWalkerEstimator : public AREstimator {
+public:
+    explicit YuleWalkerEstimator(AutocorrelationMethod method = AutocorrelationMethod::Automatic)
+        : method_(method) {}
+
+    const char* name() const override { return "yule-walker"; }
+    bool fitPath(SeriesView data, int maxOrder, LevinsonPath& path) override;
+    bool fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) override;
+
+private:
+    template <class T>
+    bool fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path);
+
+    AutocorrelationMethod method_;
+    std::vector<double> r_;
+    AutocorrelationScratch acf_;
+};
+
+// Burg's method: each reflection coefficient minimizes the summed forward
+// and backward prediction-error energy of its stage, and the error arrays
+// are updated in place after each order (one streaming pass per order,
+// O(n * P) in total). errorVariances[k] = e[k-1] * (1 - lambda_k^2) from
+// e[0] = sum x^2 / n. Always gives a stable model.
+class BurgEstimator : public AREstimator {
+public:
+    const char* name() const override { return "burg"; }
+    bool fitPath(SeriesView data, int maxOrder, LevinsonPath& path) override;
+    bool fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) override;
+
+private:
+    template <class T>
+    bool fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path);
+
+    std::vector<double> forward_;
+    std::vector<double> backward_;
+};
+
+// Modified covariance (forward-backward least squares): AR(k) minimizes the
+// forward plus backward residual energy over t = k..n-1, without the
+// windowing bias of Yule-Walker. errorVariances[k] is that minimum divided
+// by the 2 * (n - k) residuals.
+//
+// Order-recursive in the style of Marple's fast algorithm: the normal
+// matrix of order k+1 borders a rank-2 downdate of the order-k matrix, so
+// each order costs O(k) given the raw lag sums (one O(n * P) pass through
+// SimdKernels::lagProducts). Needs 2 * (n - maxOrder) > maxOrder samples.
+class ModifiedCovarianceEstimator : public AREstimator {
+public:
+    const char* name() const override { return "covariance"; }
+    bool fitPath(SeriesView data, int maxOrder, LevinsonPath& path) override;
+    bool fitPath(FloatSeriesView data, int maxOrder, LevinsonPath& path) override;
+
+private:
+    template <class T>
+    bool fit(BasicSeriesView<T> data, int maxOrder, LevinsonPath& path);
+
+    std::vector<double> lags_;      // raw lag sums of the whole series
+    std::vector<double> fwdColumn_; // forward part of the normal matrix's first column
+    std::vector<double> bwdColumn_; // backward part
+    std::vector<double> column_;    // first column q of the order-(k+1) matrix
+    std::vector<double> a_;         // R_k^-1 e_0
+    std::vector<double> pu_;        // R_k^-1 u_k (u_k: first forward row)
+    std::vector<double> pv_;        // R_k^-1 v_k (v_k: last backward row)
+    std::vector<double> f_;         // downdated solves, see the .cpp
+    std::vector<double> gu_;
+    std::vector<double> gv_;
+};
+
+#endif
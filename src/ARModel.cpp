@@ -1,102 +1,242 @@
 #include "ARModel.h"
+#include "AREstimator.h"
+#include "SimdKernels.h"
+#include "Trace.h"
 #include <cmath>
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <utility>
 
-ARModel::ARModel(const std::vector<double>& data, int order)
-    : data_(data), order_(order)
+template <class T>
+BasicARModel<T>::BasicARModel(const std::vector<T>& data, int order)
+    : ownedData_(data), data_(ownedData_), owning_(true), order_(order)
 {
 }
 
-void ARModel::computeAutocorrelation() {
-    int n = data_.size();
-    autocorrelation_.resize(order_ + 1, 0.0);
+template <class T>
+BasicARModel<T>::BasicARModel(View data, int order)
+    : data_(data), owning_(false), order_(order)
+{
+}
 
-    for (int lag = 0; lag <= order_; ++lag) {
-        double sum = 0.0;
-        for (int i = lag; i < n; ++i) {
-            sum += data_[i] * data_[i - lag];
-        }
-        autocorrelation_[lag] = sum / n;
-    }
+template <class T>
+BasicARModel<T>::BasicARModel(const BasicARModel& other)
+    : ownedData_(other.ownedData_),
+      data_(other.owning_ ? View(ownedData_) : other.data_),
+      owning_(other.owning_),
+      order_(other.order_),
+      acfMethod_(other.acfMethod_),
+      coefficients_(other.coefficients_),
+      reversedCoefficients_(other.reversedCoefficients_),
+      errorVariance_(other.errorVariance_)
+{
 }
 
-bool ARModel::computeCoefficients() {
-    if (data_.size() < static_cast<size_t>(order_)) {
-        std::cerr << "Not enough data to compute AR coefficients.\n";
-        return false;
+template <class T>
+BasicARModel<T>& BasicARModel<T>::operator=(const BasicARModel& other) {
+    if (this != &other) {
+        BasicARModel copy(other);
+        *this = std::move(copy);
     }
+    return *this;
+}
 
-    computeAutocorrelation();
-    std::vector<double> a(order_ + 1, 0.0);
-    std::vector<double> e(order_ + 1, 0.0);
+template <class T>
+void BasicARModel<T>::computeAutocorrelation(int maxLag, std::vector<double>& out) const {
+    Autocorrelation::compute(data_.data(), data_.size(), maxLag, out, acfMethod_);
+}
+
+template <class T>
+bool BasicARModel<T>::solveLevinson(const std::vector<double>& r, int order,
+                            std::vector<double>& a, std::vector<double>& e,
+                            LevinsonPath* path) {
+    AR_TRACE_SCOPE("levinson_durbin");
+    a.assign(order + 1, 0.0);
+    e.assign(order + 1, 0.0);
 
     a[0] = 1.0;
-    e[0] = autocorrelation_[0];
-    if (autocorrelation_[0] == 0.0) {
+    e[0] = r[0];
+    if (r[0] == 0.0) {
         std::cerr << "Zero lag autocorrelation. Cannot compute coefficients.\n";
         return false;
     }
 
     // Levinson-Durbin
-    for (int k = 1; k <= order_; ++k) {
+    for (int k = 1; k <= order; ++k) {
         double lambda = 0.0;
         for (int j = 1; j < k; ++j) {
-            lambda += a[j] * autocorrelation_[k - j];
+            lambda += a[j] * r[k - j];
         }
-        lambda = (autocorrelation_[k] - lambda) / e[k - 1];
+        lambda = (r[k] - lambda) / e[k - 1];
 
         a[k] = lambda;
         for (int j = 1; j < k; ++j) {
             a[j] -= lambda * a[k - j];
         }
         e[k] = e[k - 1] * (1.0 - lambda * lambda);
+
+        if (path) {
+            // Snapshot the AR(k) solution (ignore a[0] which is 1.0).
+            path->reflectionCoefficients[k] = lambda;
+            std::copy(a.begin() + 1, a.begin() + k + 1,
+                      path->coefficients.begin() + static_cast<size_t>(k) * (k - 1) / 2);
+        }
+    }
+    return true;
+}
+
+template <class T>
+bool BasicARModel<T>::levinsonDurbin(const std::vector<double>& r, int maxOrder, LevinsonPath& path) {
+    path.maxOrder = 0;
+    path.coefficients.assign(static_cast<size_t>(maxOrder) * (maxOrder + 1) / 2, 0.0);
+    path.reflectionCoefficients.assign(maxOrder + 1, 0.0);
+
+    std::vector<double> a;
+    if (!solveLevinson(r, maxOrder, a, path.errorVariances, &path)) {
+        return false;
+    }
+    path.maxOrder = maxOrder;
+    return true;
+}
+
+template <class T>
+bool BasicARModel<T>::yuleWalker(const std::vector<double>& r, int order,
+                         std::vector<double>& coefficients, double* errorVariance) {
+    ARWorkspace ws;
+    return yuleWalker(r, order, coefficients, errorVariance, ws);
+}
+
+template <class T>
+bool BasicARModel<T>::yuleWalker(const std::vector<double>& r, int order, std::vector<double>& coefficients,
+                         double* errorVariance, ARWorkspace& ws) {
+    std::vector<double>& a = ws.a;
+    std::vector<double>& e = ws.e;
+    if (!solveLevinson(r, order, a, e, nullptr)) {
+        return false;
     }
 
     // Store coefficients (ignore a[0] which is 1.0)
-    coefficients_.resize(order_);
-    for (int i = 0; i < order_; ++i) {
-        coefficients_[i] = a[i + 1];
+    coefficients.resize(order);
+    for (int i = 0; i < order; ++i) {
+        coefficients[i] = a[i + 1];
     }
+    if (errorVariance) *errorVariance = e[order];
     return true;
 }
 
-double ARModel::forwardPredict() const {
+template <class T>
+bool BasicARModel<T>::computeCoefficients() {
+    ARWorkspace ws;
+    return computeCoefficients(ws);
+}
+
+template <class T>
+bool BasicARModel<T>::computeCoefficients(ARWorkspace& ws) {
     if (data_.size() < static_cast<size_t>(order_)) {
-        std::cerr << "Insufficient data for one-step forward prediction.\n";
-        return 0.0;
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
     }
-    double prediction = 0.0;
-    for (int i = 0; i < order_; ++i) {
-        prediction += coefficients_[i] * data_[data_.size() - 1 - i];
+
+    Autocorrelation::compute(data_.data(), data_.size(), order_, ws.autocorrelation, acfMethod_, &ws.acf);
+    if (!yuleWalker(ws.autocorrelation, order_, coefficients_, &errorVariance_, ws)) {
+        return false;
     }
-    return prediction;
+    updateReversedCoefficients();
+    return true;
 }
 
-std::vector<double> ARModel::forwardPredictSteps(int k) const {
-    std::vector<double> predictions;
-    predictions.reserve(k);
+template <class T>
+bool BasicARModel<T>::fitAllOrders(int maxOrder, LevinsonPath& path) const {
+    if (maxOrder < 1 || data_.size() < static_cast<size_t>(maxOrder)) {
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
+    }
+
+    std::vector<double> r;
+    computeAutocorrelation(maxOrder, r);
+    return levinsonDurbin(r, maxOrder, path);
+}
+
+template <class T>
+bool BasicARModel<T>::fitAllOrders(int maxOrder, LevinsonPath& path, AREstimator& estimator) const {
+    return estimator.fitPath(data_, maxOrder, path);
+}
+
+template <class T>
+bool BasicARModel<T>::computeCoefficients(AREstimator& estimator) {
+    LevinsonPath path;
+    return estimator.fitPath(data_, order_, path) && selectOrder(path, order_);
+}
+
+template <class T>
+bool BasicARModel<T>::selectOrder(const LevinsonPath& path, int k) {
+    if (k < 1 || k > path.maxOrder) {
+        std::cerr << "Order " << k << " is not available in the fitted path.\n";
+        return false;
+    }
+    order_ = k;
+    const double* c = path.coefficientsFor(k);
+    coefficients_.assign(c, c + k);
+    errorVariance_ = path.errorVariances[k];
+    updateReversedCoefficients();
+    return true;
+}
 
+template <class T>
+void BasicARModel<T>::updateReversedCoefficients() {
+    reversedCoefficients_.resize(coefficients_.size());
+    std::reverse_copy(coefficients_.begin(), coefficients_.end(), reversedCoefficients_.begin());
+}
+
+template <class T>
+double BasicARModel<T>::forwardPredict() const {
     if (data_.size() < static_cast<size_t>(order_)) {
-        std::cerr << "Insufficient data for multi-step prediction.\n";
-        return predictions;
+        std::cerr << "Insufficient data for one-step forward prediction.\n";
+        return 0.0;
     }
+    // Oldest-first window times reversed coefficients: contiguous for SIMD.
+    return SimdKernels::dot(reversedCoefficients_.data(), data_.data() + data_.size() - order_, order_);
+}
 
+template <class T>
+bool BasicARModel<T>::initForecaster(RingForecaster& forecaster) const {
+    if (data_.size() < static_cast<size_t>(order_)) {
+        std::cerr << "Insufficient data for multi-step prediction.\n";
+        return false;
+    }
     // Start with the last 'order_' data points
-    std::vector<double> window(data_.end() - order_, data_.end());
+    forecaster.reset(reversedCoefficients_.data(), order_, data_.end() - order_);
+    return true;
+}
 
-    for (int step = 0; step < k; ++step) {
-        double pred = 0.0;
-        for (int i = 0; i < order_; ++i) {
-            pred += coefficients_[i] * window[order_ - 1 - i];
-        }
-        predictions.push_back(pred);
+template <class T>
+bool BasicARModel<T>::forwardPredictSteps(int k, double* out) const {
+    RingForecaster forecaster;
+    if (!initForecaster(forecaster)) {
+        return false;
+    }
+    forecaster.forecast(k, out);
+    return true;
+}
+
+template <class T>
+bool BasicARModel<T>::forwardPredictSteps(int k, double* out, ARWorkspace& ws) const {
+    if (!initForecaster(ws.forecaster)) {
+        return false;
+    }
+    ws.forecaster.forecast(k, out);
+    return true;
+}
 
-        // Shift window: remove oldest, add new pred
-        window.erase(window.begin());
-        window.push_back(pred);
+template <class T>
+std::vector<double> BasicARModel<T>::forwardPredictSteps(int k) const {
+    std::vector<double> predictions(k);
+    if (!forwardPredictSteps(k, predictions.data())) {
+        predictions.clear();
     }
     return predictions;
 }
 
+template class BasicARModel<double>;
+template class BasicARModel<float>;
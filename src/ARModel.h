@@ -1,36 +1,149 @@
 #ifndef ARMODEL_H
 #define ARMODEL_H
 
+#include <cstddef>
 #include <vector>
+#include "ARWorkspace.h"
+#include "Autocorrelation.h"
+#include "SeriesView.h"
+#include "RingForecaster.h"
 
-class ARModel {
+class AREstimator;
+
+// Every intermediate AR(k) solution produced by one Levinson-Durbin pass.
+// Coefficients for order k (k >= 1) are stored contiguously starting at
+// offset k*(k-1)/2, so the whole path takes maxOrder*(maxOrder+1)/2 doubles.
+struct LevinsonPath {
+    int maxOrder = 0;
+    std::vector<double> coefficients;           // triangular, see coefficientsFor()
+    std::vector<double> errorVariances;         // e[k], k = 0..maxOrder
+    std::vector<double> reflectionCoefficients; // lambda_k, k = 1..maxOrder ([0] unused)
+
+    const double* coefficientsFor(int k) const {
+        return coefficients.data() + static_cast<std::size_t>(k) * (k - 1) / 2;
+    }
+};
+
+// AR(p) model over samples of type T (double or float). Only the stored
+// series uses T: autocorrelations are accumulated in double, and the
+// Levinson-Durbin recursion, coefficients and forecasts are always double.
+// Use the ARModel (double) and FloatARModel aliases below.
+template <class T>
+class BasicARModel {
 public:
+    typedef T Sample;
+    typedef BasicSeriesView<T> View;
+
     // Constructor: data should be a (stationary) series, e.g., log-returns.
-    ARModel(const std::vector<double>& data, int order);
+    // The model keeps its own copy of the series.
+    BasicARModel(const std::vector<T>& data, int order);
+
+    // Zero-copy constructor: the model only references 'data', which must
+    // stay alive and unchanged for as long as the model is used. Per-model
+    // memory is then O(order).
+    BasicARModel(View data, int order);
+
+    BasicARModel(const BasicARModel& other);
+    BasicARModel& operator=(const BasicARModel& other);
+    BasicARModel(BasicARModel&&) = default;
+    BasicARModel& operator=(BasicARModel&&) = default;
 
     // Compute AR coefficients using Levinson-Durbin.
     bool computeCoefficients();
 
+    // Same, with all scratch memory taken from 'ws'. Once 'ws' and the model
+    // have been used at this order, repeated calls do not allocate.
+    bool computeCoefficients(ARWorkspace& ws);
+
+    // Fit with another estimator (Burg, modified covariance; see
+    // AREstimator.h) instead of Yule-Walker.
+    bool computeCoefficients(AREstimator& estimator);
+
+    // Fit every order 1..maxOrder from a single autocorrelation pass and a
+    // single Levinson-Durbin recursion. Does not change the model's own order.
+    bool fitAllOrders(int maxOrder, LevinsonPath& path) const;
+
+    // Same, with every order taken from one order-recursive pass of
+    // 'estimator'.
+    bool fitAllOrders(int maxOrder, LevinsonPath& path, AREstimator& estimator) const;
+
+    // Switch the model to order k using coefficients from a previous
+    // fitAllOrders() call (k must not exceed path.maxOrder).
+    bool selectOrder(const LevinsonPath& path, int k);
+
     // One-step forward prediction based on the last 'order_' data points.
     double forwardPredict() const;
 
     // Multi-step forward prediction (recursive).
     std::vector<double> forwardPredictSteps(int k) const;
 
+    // Multi-step forward prediction into caller storage out[0..k). Returns
+    // false (and leaves 'out' untouched) if there is not enough data.
+    bool forwardPredictSteps(int k, double* out) const;
+
+    // Same, reusing the forecaster in 'ws' (allocation-free after warm-up).
+    bool forwardPredictSteps(int k, double* out, ARWorkspace& ws) const;
+
+    // Arm 'forecaster' with this model's coefficients and the last 'order'
+    // observations. The forecaster references the model's coefficients, so
+    // the model must outlive it.
+    bool initForecaster(RingForecaster& forecaster) const;
+
+    // Solve the Yule-Walker equations for a single order from autocorrelations
+    // r[0..order]. Writes 'order' coefficients and, optionally, e[order].
+    static bool yuleWalker(const std::vector<double>& r, int order,
+                           std::vector<double>& coefficients, double* errorVariance = nullptr);
+
+    // Same, with the recursion's scratch vectors taken from 'ws'.
+    static bool yuleWalker(const std::vector<double>& r, int order, std::vector<double>& coefficients,
+                           double* errorVariance, ARWorkspace& ws);
+
+    // Levinson-Durbin recursion on autocorrelations r[0..maxOrder]. Fills the
+    // full path; returns false if r[0] is zero.
+    static bool levinsonDurbin(const std::vector<double>& r, int maxOrder, LevinsonPath& path);
+
+    // Choose how autocorrelations are computed (default: automatic crossover
+    // between the direct lag-product loop and the FFT path).
+    void setAutocorrelationMethod(AutocorrelationMethod method) { acfMethod_ = method; }
+    AutocorrelationMethod autocorrelationMethod() const { return acfMethod_; }
+
+    // True if the model owns a copy of its series rather than a view.
+    bool ownsData() const { return owning_; }
+    View data() const { return data_; }
+
 private:
-    std::vector<double> data_;
+    std::vector<T> ownedData_; // empty for view-constructed models
+    View data_;                // points into ownedData_ or caller memory
+    bool owning_;
     int order_;
+    AutocorrelationMethod acfMethod_ = AutocorrelationMethod::Automatic;
     std::vector<double> coefficients_;
-    std::vector<double> autocorrelation_;
+    std::vector<double> reversedCoefficients_; // phi_p..phi_1, matches an oldest-first window
+    double errorVariance_ = 0.0;            // e[order_] from the last fit
+
+    // Compute autocorrelation up to 'maxLag' into 'out'.
+    void computeAutocorrelation(int maxLag, std::vector<double>& out) const;
 
-    // Compute autocorrelation up to 'order_'.
-    void computeAutocorrelation();
+    // Keep reversedCoefficients_ in sync after coefficients_ changes.
+    void updateReversedCoefficients();
+
+    // Shared recursion; records every intermediate order into 'path' if given.
+    static bool solveLevinson(const std::vector<double>& r, int order,
+                              std::vector<double>& a, std::vector<double>& e,
+                              LevinsonPath* path);
 
 public:
     // Accessors
     const std::vector<double>& getCoefficients() const { return coefficients_; }
+    int getOrder() const { return order_; }
+    // Innovation (prediction-error) variance e[order] of the fitted model.
+    double getErrorVariance() const { return errorVariance_; }
 };
 
-#endif
+typedef BasicARModel<double> ARModel;
+typedef BasicARModel<float> FloatARModel; // single-precision storage, double fit
 
+extern template class BasicARModel<double>;
+extern template class BasicARModel<float>;
 
+#endif
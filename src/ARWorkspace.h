@@ -0,0 +1,44 @@
+#ifndef AR_WORKSPACE_H
+#define AR_WORKSPACE_H
+
+#include <cstddef>
+#include <vector>
+#include "Autocorrelation.h"
+#include "RingForecaster.h"
+
+// Caller-owned scratch memory for ARModel fits and forecasts.
+//
+// Pass the same workspace to repeated computeCoefficients() and
+// forwardPredictSteps() calls: after the first call at the largest order (or
+// after reserve()), they perform no heap allocations. A workspace must not be
+// shared by threads running at the same time; use one per thread.
+class ARWorkspace {
+public:
+    ARWorkspace() {}
+    // Pre-size for orders up to maxOrder; fftSamples > 0 also pre-sizes the
+    // FFT autocorrelation buffers for series of up to that many samples.
+    explicit ARWorkspace(int maxOrder, std::size_t fftSamples = 0) { reserve(maxOrder, fftSamples); }
+
+    void reserve(int maxOrder, std::size_t fftSamples = 0) {
+        std::size_t p = static_cast<std::size_t>(maxOrder) + 1;
+        autocorrelation.reserve(p);
+        a.reserve(p);
+        e.reserve(p);
+        forecaster.reserve(maxOrder);
+        if (fftSamples > 0) {
+            std::size_t m = 1;
+            while (m < fftSamples + maxOrder) m <<= 1;
+            acf.spectrum.reserve(m / 2);
+            acf.twiddle.reserve(m / 4);
+            acf.power.reserve(m / 2 + 1);
+        }
+    }
+
+    std::vector<double> autocorrelation; // r[0..order]
+    std::vector<double> a;               // Levinson-Durbin polynomial
+    std::vector<double> e;               // prediction-error variances
+    AutocorrelationScratch acf;          // FFT path buffers
+    RingForecaster forecaster;           // multi-step forecast state
+};
+
+#endif
@@ -0,0 +1,335 @@
+#include "ArtifactWriter.h"
+#include "SeriesIO.h"
+#include "Trace.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+ArtifactFileHeader makeHeader(std::uint64_t records) {
+    ArtifactFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "ARCN", 4);
+    h.version = ArtifactWriter::kVersion;
+    h.dtype = SeriesIO::Float64;
+    h.headerSize = sizeof(ArtifactFileHeader);
+    h.records = records;
+    return h;
+}
+
+std::size_t paddedKeyBytes(const std::string& key) {
+    return (key.size() + 1 + 7) & ~std::size_t(7);
+}
+
+void append(std::vector<char>& out, const void* data, std::size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    out.insert(out.end(), p, p + bytes);
+}
+
+// RFC 4180: a key holding a comma, quote or line break is quoted, with its
+// quotes doubled.
+void appendCsvKey(std::vector<char>& out, const std::string& key) {
+    if (key.find_first_of(",\"\r\n") == std::string::npos) {
+        append(out, key.data(), key.size());
+        return;
+    }
+    out.push_back('"');
+    for (char ch : key) {
+        if (ch == '"') out.push_back('"');
+        out.push_back(ch);
+    }
+    out.push_back('"');
+}
+
+bool writeScalarText(const std::string& filename, double value) {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return false;
+    }
+    outFile << value << "\n";
+    return static_cast<bool>(outFile);
+}
+
+bool readContainer(const std::string& path, std::vector<Artifact>& out) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Error opening " << path << " for reading.\n";
+        return false;
+    }
+    std::vector<char> bytes;
+    long size = std::fseek(f, 0, SEEK_END) == 0 ? std::ftell(f) : -1;
+    bool ok = size >= static_cast<long>(sizeof(ArtifactFileHeader)) && std::fseek(f, 0, SEEK_SET) == 0;
+    if (ok) {
+        bytes.resize(static_cast<std::size_t>(size));
+        ok = std::fread(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    }
+    std::fclose(f);
+
+    ArtifactFileHeader h;
+    if (ok) {
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        ok = std::memcmp(h.magic, "ARCN", 4) == 0 && h.version == ArtifactWriter::kVersion &&
+             h.headerSize == sizeof(ArtifactFileHeader) && h.dtype == SeriesIO::Float64;
+    }
+    if (!ok) {
+        std::cerr << "Not a valid artifact container: " << path << ".\n";
+        return false;
+    }
+    std::size_t pos = h.headerSize;
+    while (pos < bytes.size()) {
+        ArtifactRecordHeader r;
+        if (bytes.size() - pos < sizeof(r)) break;
+        std::memcpy(&r, bytes.data() + pos, sizeof(r));
+        pos += sizeof(r);
+        if (r.keyBytes == 0 || bytes.size() - pos < r.keyBytes ||
+            (bytes.size() - pos - r.keyBytes) / sizeof(double) < r.length) {
+            break;
+        }
+        Artifact a;
+        const char* key = bytes.data() + pos;
+        const void* nul = std::memchr(key, '\0', r.keyBytes);
+        a.key.assign(key, nul ? static_cast<const char*>(nul) - key : r.keyBytes);
+        pos += r.keyBytes;
+        a.values.resize(r.length);
+        if (r.length > 0) std::memcpy(a.values.data(), bytes.data() + pos, r.length * sizeof(double));
+        pos += r.length * sizeof(double);
+        a.scalar = (r.flags & ArtifactWriter::kScalar) != 0;
+        out.push_back(std::move(a));
+    }
+    // A container that was never closed has records == 0; take what is there.
+    if (pos != bytes.size() || (h.records != 0 && h.records != out.size())) {
+        std::cerr << "Artifact container " << path << " is truncated.\n";
+        return false;
+    }
+    return true;
+}
+
+bool readCsv(const std::string& path, std::vector<Artifact>& out) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error opening " << path << " for reading.\n";
+        return false;
+    }
+    std::string line;
+    std::getline(in, line); // key,index,value
+    while (std::getline(in, line)) {
+        // A quoted key may span lines: read on until its closing quote.
+        std::string key;
+        std::size_t a = 0;
+        if (!line.empty() && line[0] == '"') {
+            for (a = 1;; ++a) {
+                if (a == line.size()) {
+                    std::string next;
+                    if (!std::getline(in, next)) break;
+                    line += '\n';
+                    line += next;
+                }
+                if (line[a] != '"') {
+                    key += line[a];
+                } else if (a + 1 < line.size() && line[a + 1] == '"') {
+                    key += '"';
+                    ++a;
+                } else {
+                    ++a;
+                    break;
+                }
+            }
+            if (a >= line.size() || line[a] != ',') a = std::string::npos;
+        } else {
+            a = line.find(',');
+            if (a != std::string::npos) key = line.substr(0, a);
+        }
+        std::size_t b = a == std::string::npos ? a : line.find(',', a + 1);
+        if (b == std::string::npos) {
+            std::cerr << "Malformed artifact row in " << path << ": " << line << "\n";
+            return false;
+        }
+        // "key,," (no index, no value) is a series with no values.
+        bool empty = b == a + 1 && b + 1 == line.size();
+        if (out.empty() || out.back().key != key || empty) {
+            out.push_back(Artifact());
+            out.back().key = key;
+            out.back().scalar = (b == a + 1) && !empty;
+        }
+        if (!empty) out.back().values.push_back(std::strtod(line.c_str() + b + 1, nullptr));
+    }
+    return true;
+}
+
+} // namespace
+
+ArtifactWriter::ArtifactWriter(Sink sink, const std::string& path, std::size_t maxQueuedBytes)
+    : sink_(sink), path_(path), maxQueuedBytes_(maxQueuedBytes)
+{
+    if (sink_ == Container || sink_ == Csv) ok_ = openContainer();
+    thread_ = std::thread([this] { ioLoop(); });
+}
+
+ArtifactWriter::~ArtifactWriter() {
+    close();
+}
+
+bool ArtifactWriter::openContainer() {
+    file_ = std::fopen(path_.c_str(), sink_ == Csv ? "w" : "wb");
+    if (!file_) {
+        std::cerr << "Error opening " << path_ << " for writing.\n";
+        return false;
+    }
+    if (sink_ == Csv) return std::fputs("key,index,value\n", file_) >= 0;
+    // Placeholder header; close() fills in the record count.
+    ArtifactFileHeader h = makeHeader(0);
+    return std::fwrite(&h, sizeof(h), 1, file_) == 1;
+}
+
+void ArtifactWriter::put(const std::string& key, std::vector<double> values) {
+    Artifact a;
+    a.key = key;
+    a.values = std::move(values);
+    enqueue(std::move(a));
+}
+
+void ArtifactWriter::put(const std::string& key, const double* data, std::size_t n) {
+    put(key, std::vector<double>(data, data + n));
+}
+
+void ArtifactWriter::put(const std::string& key, double value) {
+    Artifact a;
+    a.key = key;
+    a.values.assign(1, value);
+    a.scalar = true;
+    enqueue(std::move(a));
+}
+
+void ArtifactWriter::enqueue(Artifact&& artifact) {
+    std::size_t bytes = artifact.values.size() * sizeof(double);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        std::cerr << "ArtifactWriter: '" << artifact.key << "' queued after close(); dropped.\n";
+        return;
+    }
+    // Only a writer far behind the producer makes put() wait.
+    drained_.wait(lock, [&] { return queuedBytes_ == 0 || queuedBytes_ + bytes <= maxQueuedBytes_; });
+    queuedBytes_ += bytes;
+    ++enqueued_;
+    queue_.push_back(std::move(artifact));
+    wake_.notify_one();
+}
+
+void ArtifactWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::uint64_t target = enqueued_;
+    drained_.wait(lock, [&] { return written_ >= target; });
+}
+
+bool ArtifactWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) return ok_;
+        closed_ = true;
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+
+    if (file_) {
+        bool ok = true;
+        if (sink_ == Container) {
+            ArtifactFileHeader h = makeHeader(records_);
+            ok = std::fseek(file_, 0, SEEK_SET) == 0 && std::fwrite(&h, sizeof(h), 1, file_) == 1;
+        }
+        ok = (std::fclose(file_) == 0) && ok;
+        file_ = nullptr;
+        if (!ok) std::cerr << "Error writing " << path_ << ".\n";
+        ok_ = ok_ && ok;
+    }
+    return ok_;
+}
+
+void ArtifactWriter::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) break; // stopping, and everything is written
+        writing_.swap(queue_);
+        lock.unlock();
+
+        std::size_t bytes = 0;
+        for (const Artifact& a : writing_) bytes += a.values.size() * sizeof(double);
+        bool ok = writeBatch(writing_);
+        std::size_t count = writing_.size();
+        writing_.clear();
+
+        lock.lock();
+        ok_ = ok_ && ok;
+        written_ += count;
+        queuedBytes_ -= bytes;
+        drained_.notify_all();
+    }
+}
+
+bool ArtifactWriter::writeBatch(std::vector<Artifact>& batch) {
+    AR_TRACE_SCOPE("artifact_write");
+    AR_TRACE_COUNT("artifact_records", batch.size());
+    bool ok = true;
+    switch (sink_) {
+    case TextFiles:
+    case BinaryFiles:
+        for (const Artifact& a : batch) {
+            if (a.scalar) {
+                ok = writeScalarText(a.key + ".txt", a.values[0]) && ok;
+            } else if (sink_ == BinaryFiles) {
+                ok = SeriesIO::writeBinary(a.key + ".bin", a.values) && ok;
+            } else {
+                ok = SeriesIO::writeText(a.key + ".txt", a.values) && ok;
+            }
+        }
+        return ok;
+    case Container:
+        // Encode the whole batch, then hand it to the OS in one write.
+        encoded_.clear();
+        for (const Artifact& a : batch) {
+            ArtifactRecordHeader r;
+            r.keyBytes = static_cast<std::uint32_t>(paddedKeyBytes(a.key));
+            r.flags = a.scalar ? kScalar : 0;
+            r.length = a.values.size();
+            append(encoded_, &r, sizeof(r));
+            append(encoded_, a.key.c_str(), a.key.size());
+            encoded_.resize(encoded_.size() + (r.keyBytes - a.key.size()), '\0');
+            append(encoded_, a.values.data(), a.values.size() * sizeof(double));
+        }
+        records_ += batch.size();
+        break;
+    case Csv: {
+        encoded_.clear();
+        char buf[64];
+        for (const Artifact& a : batch) {
+            if (a.values.empty()) {
+                // One row with neither index nor value keeps the series.
+                appendCsvKey(encoded_, a.key);
+                append(encoded_, ",,\n", 3);
+            }
+            for (std::size_t i = 0; i < a.values.size(); ++i) {
+                int len = a.scalar ? std::snprintf(buf, sizeof(buf), ",,%.17g\n", a.values[i])
+                                   : std::snprintf(buf, sizeof(buf), ",%zu,%.17g\n", i, a.values[i]);
+                appendCsvKey(encoded_, a.key);
+                append(encoded_, buf, static_cast<std::size_t>(len));
+            }
+        }
+        break;
+    }
+    }
+    if (!file_) return false;
+    ok = encoded_.empty() || std::fwrite(encoded_.data(), 1, encoded_.size(), file_) == encoded_.size();
+    if (!ok) std::cerr << "Error writing " << path_ << ".\n";
+    return ok;
+}
+
+bool ArtifactWriter::read(const std::string& path, std::vector<Artifact>& out) {
+    out.clear();
+    bool csv = path.size() > 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    return csv ? readCsv(path, out) : readContainer(path, out);
+}
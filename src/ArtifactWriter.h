@@ -0,0 +1,106 @@
+#ifndef ARTIFACT_WRITER_H
+#define ARTIFACT_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One named result buffer: a series or a single value.
+struct Artifact {
+    std::string key;
+    std::vector<double> values;
+    bool scalar = false;
+};
+
+// Artifact container file (".arc"): a 32-byte little-endian header, then one
+// record per artifact: a 16-byte record header, the key (NUL-padded to a
+// multiple of 8 bytes) and 'length' float64 values, so every payload stays
+// 8-byte aligned.
+struct ArtifactFileHeader {
+    char magic[4];          // "ARCN"
+    std::uint16_t version;  // ArtifactWriter::kVersion
+    std::uint16_t dtype;    // SeriesIO::Float64
+    std::uint32_t headerSize;
+    std::uint32_t reserved;
+    std::uint64_t records;  // filled in by close()
+    std::uint64_t reserved2;
+};
+
+struct ArtifactRecordHeader {
+    std::uint32_t keyBytes; // padded key size
+    std::uint32_t flags;    // ArtifactWriter::kScalar
+    std::uint64_t length;
+};
+
+// Writes run artifacts from a background I/O thread so the compute thread
+// never waits on the disk. put() only moves the buffer onto a queue; the I/O
+// thread swaps the whole queue out (double buffering: one batch fills while
+// the previous one is written), encodes the batch and writes it.
+//
+// TextFiles and BinaryFiles write one file per artifact, as the plotting
+// scripts expect (key + ".txt", or ".bin" via SeriesIO; scalars are always
+// text). Container and Csv coalesce the run into the single file 'path':
+// the .arc format above, or "key,index,value" rows with round-trip precision
+// (keys quoted per RFC 4180 where needed; scalars leave the index empty, and
+// an empty series is one "key,," row).
+class ArtifactWriter {
+public:
+    enum Sink { TextFiles, BinaryFiles, Container, Csv };
+    static const std::uint16_t kVersion = 1;
+    static const std::uint32_t kScalar = 1;
+
+    // path: the container file (ignored by the per-file sinks). put() blocks
+    // only while more than 'maxQueuedBytes' are waiting to be written.
+    explicit ArtifactWriter(Sink sink, const std::string& path = std::string(),
+                            std::size_t maxQueuedBytes = std::size_t(256) << 20);
+    ~ArtifactWriter();
+
+    ArtifactWriter(const ArtifactWriter&) = delete;
+    ArtifactWriter& operator=(const ArtifactWriter&) = delete;
+
+    void put(const std::string& key, std::vector<double> values);
+    void put(const std::string& key, const double* data, std::size_t n);
+    void put(const std::string& key, double value);
+
+    // Wait until everything queued so far is written.
+    void flush();
+    // Flush, stop the I/O thread and finish the container. False if any
+    // write failed. Called by the destructor.
+    bool close();
+
+    // Read back a Container or Csv file (by extension: ".csv" or not).
+    static bool read(const std::string& path, std::vector<Artifact>& out);
+
+private:
+    void enqueue(Artifact&& artifact);
+    void ioLoop();
+    bool writeBatch(std::vector<Artifact>& batch);
+    bool openContainer();
+
+    Sink sink_;
+    std::string path_;
+    std::size_t maxQueuedBytes_;
+    std::FILE* file_ = nullptr;
+    std::uint64_t records_ = 0;
+    std::vector<char> encoded_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;    // I/O thread: work or stop
+    std::condition_variable drained_; // producers: space or flushed
+    std::vector<Artifact> queue_;     // filled by put()
+    std::vector<Artifact> writing_;   // owned by the I/O thread
+    std::size_t queuedBytes_ = 0;
+    std::uint64_t enqueued_ = 0;
+    std::uint64_t written_ = 0;
+    bool stop_ = false;
+    bool closed_ = false;
+    bool ok_ = true;
+    std::thread thread_;
+};
+
+#endif
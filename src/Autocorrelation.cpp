@@ -0,0 +1,180 @@
+#include "Autocorrelation.h"
+#include "SimdKernels.h"
+#include "Trace.h"
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+const double kPi = 3.14159265358979323846;
+
+// Rough cost of one FFT butterfly relative to one direct multiply-add,
+// covering the forward and inverse transforms plus the spectrum pass.
+const double kFftCostFactor = 6.0;
+
+std::size_t nextPowerOfTwo(std::size_t v) {
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// Forward twiddles exp(-2*pi*i*j/m), j < m/2, for an m-point transform.
+void prepareTwiddles(std::vector<Complex>& twiddle, std::size_t m) {
+    if (twiddle.size() == m / 2) return;
+    twiddle.resize(m / 2);
+    for (std::size_t j = 0; j < m / 2; ++j) {
+        twiddle[j] = std::polar(1.0, -2.0 * kPi * j / m);
+    }
+}
+
+// In-place iterative radix-2 FFT of length m (power of two).
+// sign = -1 for the forward transform, +1 for the (unscaled) inverse.
+void fftInPlace(std::vector<Complex>& a, const std::vector<Complex>& twiddle, int sign) {
+    std::size_t m = a.size();
+    for (std::size_t i = 1, j = 0; i < m; ++i) {
+        std::size_t bit = m >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+
+    for (std::size_t len = 2; len <= m; len <<= 1) {
+        std::size_t half = len / 2;
+        std::size_t stride = m / len;
+        for (std::size_t i = 0; i < m; i += len) {
+            for (std::size_t j = 0; j < half; ++j) {
+                Complex w = sign < 0 ? twiddle[j * stride] : std::conj(twiddle[j * stride]);
+                Complex t = a[i + j + half] * w;
+                a[i + j + half] = a[i + j] - t;
+                a[i + j] += t;
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool Autocorrelation::prefersFFT(std::size_t n, int maxLag) {
+    if (n < 64 || maxLag < 16) return false;
+    double bigN = static_cast<double>(nextPowerOfTwo(n + maxLag));
+    double directCost = static_cast<double>(n) * (maxLag + 1);
+    double fftCost = kFftCostFactor * bigN * std::log2(bigN);
+    return fftCost < directCost;
+}
+
+namespace {
+
+template <class T>
+void computeDirectImpl(const T* x, std::size_t n, int maxLag, std::vector<double>& out) {
+    out.assign(maxLag + 1, 0.0);
+    SimdKernels::lagProducts(x, n, maxLag, out.data());
+    for (int lag = 0; lag <= maxLag; ++lag) {
+        out[lag] /= n;
+    }
+}
+
+template <class T>
+void computeFFTImpl(const T* x, std::size_t n, int maxLag, std::vector<double>& out,
+                    AutocorrelationScratch* scratch) {
+    out.assign(maxLag + 1, 0.0);
+    if (n == 0) return;
+    AutocorrelationScratch local;
+    AutocorrelationScratch& ws = scratch ? *scratch : local;
+
+    // Zero-pad to N >= n + maxLag so circular lags up to maxLag do not wrap.
+    // The real signal of length N is packed into N/2 complex samples
+    // z[m] = x[2m] + i*x[2m+1], halving the transform length.
+    std::size_t bigN = std::max<std::size_t>(4, nextPowerOfTwo(n + maxLag));
+    std::size_t m = bigN / 2;
+
+    std::vector<Complex>& z = ws.spectrum;
+    z.assign(m, Complex(0.0, 0.0));
+    prepareTwiddles(ws.twiddle, m);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i & 1) z[i / 2].imag(x[i]);
+        else z[i / 2].real(x[i]);
+    }
+    fftInPlace(z, ws.twiddle, -1);
+
+    // Unpack X[k] for k = 0..N/2 and form the power spectrum P[k] = |X[k]|^2.
+    std::vector<double>& power = ws.power;
+    power.resize(m + 1);
+    for (std::size_t k = 0; k <= m; ++k) {
+        Complex zk = z[k % m];
+        Complex zc = std::conj(z[(m - k) % m]);
+        Complex even = 0.5 * (zk + zc);
+        Complex odd = Complex(0.0, -0.5) * (zk - zc);
+        Complex xk = even + std::polar(1.0, -2.0 * kPi * k / bigN) * odd;
+        power[k] = std::norm(xk);
+    }
+
+    // Inverse of the real, even spectrum, packed the same way:
+    // Z[k] = E[k] + i*O[k] with E[k] = (P[k] + P[k+N/2]) / 2 and
+    // O[k] = (P[k] - P[k+N/2]) * exp(+2*pi*i*k/N) / 2, using P[k+N/2] = P[N/2-k].
+    for (std::size_t k = 0; k < m; ++k) {
+        double pk = power[k];
+        double pk2 = power[m - k];
+        Complex even(0.5 * (pk + pk2), 0.0);
+        Complex odd = 0.5 * (pk - pk2) * std::polar(1.0, 2.0 * kPi * k / bigN);
+        z[k] = even + Complex(0.0, 1.0) * odd;
+    }
+    fftInPlace(z, ws.twiddle, +1);
+
+    double scale = 1.0 / (static_cast<double>(m) * n);
+    for (int lag = 0; lag <= maxLag; ++lag) {
+        std::size_t idx = static_cast<std::size_t>(lag);
+        double v = (idx & 1) ? z[idx / 2].imag() : z[idx / 2].real();
+        out[lag] = v * scale;
+    }
+}
+
+template <class T>
+void computeImpl(const T* x, std::size_t n, int maxLag, std::vector<double>& out,
+                 AutocorrelationMethod method, AutocorrelationScratch* scratch) {
+    AR_TRACE_SCOPE("autocorrelation");
+    AR_TRACE_COUNT("autocorrelation_samples", n);
+    if (method == AutocorrelationMethod::Automatic) {
+        method = Autocorrelation::prefersFFT(n, maxLag) ? AutocorrelationMethod::FFT : AutocorrelationMethod::Direct;
+    }
+    if (method == AutocorrelationMethod::FFT) {
+        computeFFTImpl(x, n, maxLag, out, scratch);
+    } else {
+        computeDirectImpl(x, n, maxLag, out);
+    }
+}
+
+} // namespace
+
+void Autocorrelation::compute(const double* x, std::size_t n, int maxLag,
+                              std::vector<double>& out, AutocorrelationMethod method,
+                              AutocorrelationScratch* scratch) {
+    computeImpl(x, n, maxLag, out, method, scratch);
+}
+
+void Autocorrelation::compute(const float* x, std::size_t n, int maxLag,
+                              std::vector<double>& out, AutocorrelationMethod method,
+                              AutocorrelationScratch* scratch) {
+    computeImpl(x, n, maxLag, out, method, scratch);
+}
+
+void Autocorrelation::computeDirect(const double* x, std::size_t n, int maxLag, std::vector<double>& out) {
+    computeDirectImpl(x, n, maxLag, out);
+}
+
+void Autocorrelation::computeDirect(const float* x, std::size_t n, int maxLag, std::vector<double>& out) {
+    computeDirectImpl(x, n, maxLag, out);
+}
+
+void Autocorrelation::computeFFT(const double* x, std::size_t n, int maxLag, std::vector<double>& out,
+                                 AutocorrelationScratch* scratch) {
+    computeFFTImpl(x, n, maxLag, out, scratch);
+}
+
+void Autocorrelation::computeFFT(const float* x, std::size_t n, int maxLag, std::vector<double>& out,
+                                 AutocorrelationScratch* scratch) {
+    computeFFTImpl(x, n, maxLag, out, scratch);
+}
@@ -0,0 +1,51 @@
+#ifndef AUTOCORRELATION_H
+#define AUTOCORRELATION_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Strategy used to compute biased sample autocorrelations.
+enum class AutocorrelationMethod {
+    Automatic, // pick Direct or FFT from (n, maxLag), see Autocorrelation::prefersFFT
+    Direct,    // O(n * maxLag) lag products
+    FFT        // O(N log N) via zero-padded Wiener-Khinchin, N >= n + maxLag
+};
+
+// Reusable buffers for the FFT path. Once sized by the largest transform,
+// repeated calls with the same scratch do not allocate.
+struct AutocorrelationScratch {
+    std::vector<std::complex<double> > spectrum;
+    std::vector<std::complex<double> > twiddle; // forward twiddles, cached per size
+    std::vector<double> power;
+};
+
+class Autocorrelation {
+public:
+    // r[lag] = (1/n) * sum_{i=lag}^{n-1} x[i] * x[i-lag], lag = 0..maxLag.
+    // 'out' is resized to maxLag + 1.
+    // The FFT path uses 'scratch' for its buffers when given, and temporary
+    // storage otherwise. 'out' only reallocates if it has too little capacity.
+    static void compute(const double* x, std::size_t n, int maxLag,
+                        std::vector<double>& out,
+                        AutocorrelationMethod method = AutocorrelationMethod::Automatic,
+                        AutocorrelationScratch* scratch = nullptr);
+    // Float samples; products, sums and the FFT all run in double.
+    static void compute(const float* x, std::size_t n, int maxLag,
+                        std::vector<double>& out,
+                        AutocorrelationMethod method = AutocorrelationMethod::Automatic,
+                        AutocorrelationScratch* scratch = nullptr);
+
+    static void computeDirect(const double* x, std::size_t n, int maxLag, std::vector<double>& out);
+    static void computeDirect(const float* x, std::size_t n, int maxLag, std::vector<double>& out);
+    static void computeFFT(const double* x, std::size_t n, int maxLag, std::vector<double>& out,
+                           AutocorrelationScratch* scratch = nullptr);
+    static void computeFFT(const float* x, std::size_t n, int maxLag, std::vector<double>& out,
+                           AutocorrelationScratch* scratch = nullptr);
+
+    // Crossover heuristic: true when the estimated FFT cost beats the direct
+    // lag-product loop for this series length and maximum lag.
+    static bool prefersFFT(std::size_t n, int maxLag);
+};
+
+#endif
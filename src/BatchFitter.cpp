@@ -0,0 +1,82 @@
+#include "BatchFitter.h"
+#include "ARModel.h"
+#include "PanelIO.h"
+#include "Trace.h"
+#include <algorithm>
+#include <iostream>
+
+BatchFitter::BatchFitter(int threads, const std::vector<int>& affinity)
+    : pool_(threads, affinity), backend_(ComputeBackend::Cpu)
+{
+}
+
+namespace {
+
+template <class T>
+BatchFitResult fitAll(ThreadPool& pool, ComputeBackend backend, const BasicSeriesCollection<T>& collection,
+                      int order, AutocorrelationMethod method) {
+    AR_TRACE_SCOPE("batch_fit");
+    BatchFitResult result;
+    if (backend == ComputeBackend::Cuda) {
+        AR_TRACE_SCOPE("batch_fit.gpu");
+        if (GpuBackend::fitBatch(collection, order, result)) return result;
+        GpuBackend::warnFallback("Batch fit");
+    }
+    result.order = order;
+    result.count = collection.size();
+    result.coefficients.assign(result.count * order, 0.0);
+    result.errorVariances.assign(result.count, 0.0);
+    result.ok.assign(result.count, 0);
+
+    // The same steps as ARModel::computeCoefficients(), with the checks that
+    // would print done here: failures are only flagged on the workers and
+    // reported once below, from the calling thread.
+    struct Worker {
+        ARWorkspace ws;
+        std::vector<double> coefficients;
+    };
+    std::vector<Worker> workers(pool.concurrency());
+    // Small chunks keep the load balanced when series lengths differ.
+    std::size_t grain = std::max<std::size_t>(1, result.count / (8 * pool.concurrency()));
+    pool.parallelFor(result.count, grain, [&](std::size_t begin, std::size_t end, int worker) {
+        Worker& w = workers[worker];
+        for (std::size_t i = begin; i < end; ++i) {
+            const BasicSeriesView<T>& s = collection.series[i];
+            if (s.size() < static_cast<std::size_t>(order)) continue;
+            Autocorrelation::compute(s.data(), s.size(), order, w.ws.autocorrelation, method, &w.ws.acf);
+            if (w.ws.autocorrelation[0] == 0.0) continue;
+            double variance = 0.0;
+            if (!BasicARModel<T>::yuleWalker(w.ws.autocorrelation, order, w.coefficients, &variance, w.ws)) {
+                continue;
+            }
+            std::copy(w.coefficients.begin(), w.coefficients.end(), result.coefficients.begin() + i * order);
+            result.errorVariances[i] = variance;
+            result.ok[i] = 1;
+        }
+    });
+    std::size_t failed = static_cast<std::size_t>(std::count(result.ok.begin(), result.ok.end(), 0));
+    if (failed > 0) {
+        std::cerr << "Batch fit: " << failed << " of " << result.count << " series could not be fitted at order "
+                  << order << " (too short or all zeros).\n";
+    }
+    return result;
+}
+
+} // namespace
+
+BatchFitResult BatchFitter::fitBatch(const SeriesCollection& collection, int order,
+                                     AutocorrelationMethod method) {
+    return fitAll(pool_, backend_, collection, order, method);
+}
+
+BatchFitResult BatchFitter::fitBatch(const FloatSeriesCollection& collection, int order,
+                                     AutocorrelationMethod method) {
+    return fitAll(pool_, backend_, collection, order, method);
+}
+
+BatchFitResult BatchFitter::fitBatch(const Panel& levels, int order, SeriesTransform transform,
+                                     AutocorrelationMethod method) {
+    Panel transformed;
+    Transforms::apply(transform, levels, transformed, 1, &pool_);
+    return fitAll(pool_, backend_, transformed.collection(), order, method);
+}
@@ -0,0 +1,78 @@
+#ifndef BATCH_FITTER_H
+#define BATCH_FITTER_H
+
+#include <cstddef>
+#include <vector>
+#include "Autocorrelation.h"
+#include "GpuBackend.h"
+#include "SeriesView.h"
+#include "ThreadPool.h"
+#include "Transforms.h"
+
+// A set of independent series, each referenced by a non-owning view.
+template <class T>
+struct BasicSeriesCollection {
+    std::vector<BasicSeriesView<T> > series;
+
+    void add(BasicSeriesView<T> s) { series.push_back(s); }
+    std::size_t size() const { return series.size(); }
+};
+
+typedef BasicSeriesCollection<double> SeriesCollection;
+typedef BasicSeriesCollection<float> FloatSeriesCollection;
+
+// Structure-of-arrays fit results: row i of 'coefficients' (length 'order')
+// belongs to series i.
+struct BatchFitResult {
+    int order = 0;
+    std::size_t count = 0;
+    std::vector<double> coefficients;   // count * order, row-major
+    std::vector<double> errorVariances; // count
+    std::vector<unsigned char> ok;      // count; 0 where the fit failed
+
+    const double* coefficientsFor(std::size_t i) const {
+        return coefficients.data() + i * order;
+    }
+};
+
+// Fits one AR(order) model per series across a work-stealing thread pool.
+// Each worker runs the autocorrelation and Levinson-Durbin steps itself in
+// its own ARWorkspace; the coefficients and error variances are bit for bit
+// those of ARModel::computeCoefficients() (ar_harness checks this with a
+// zero tolerance).
+//
+// With setBackend(ComputeBackend::Cuda) the whole batch goes to GpuBackend
+// instead, falling back to the pool while no device backend is available.
+class BatchFitter {
+public:
+    // threads: threads per batch, counting the caller (0 = hardware
+    // concurrency; see ThreadPool).
+    // affinity: optional CPU ids to pin workers to.
+    explicit BatchFitter(int threads = 0, const std::vector<int>& affinity = std::vector<int>());
+
+    BatchFitResult fitBatch(const SeriesCollection& collection, int order,
+                            AutocorrelationMethod method = AutocorrelationMethod::Automatic);
+
+    // Single-precision series: half the memory traffic per fit, with the
+    // same double-precision accumulation and recursion.
+    BatchFitResult fitBatch(const FloatSeriesCollection& collection, int order,
+                            AutocorrelationMethod method = AutocorrelationMethod::Automatic);
+
+    // Level series (e.g. a price panel from PanelIO): every column is
+    // transformed on the pool (Transforms::apply) into a temporary panel,
+    // whose columns are then fitted as above.
+    BatchFitResult fitBatch(const Panel& levels, int order,
+                            SeriesTransform transform = SeriesTransform::Difference,
+                            AutocorrelationMethod method = AutocorrelationMethod::Automatic);
+
+    void setBackend(ComputeBackend backend) { backend_ = backend; }
+    ComputeBackend backend() const { return backend_; }
+
+    ThreadPool& pool() { return pool_; }
+
+private:
+    ThreadPool pool_;
+    ComputeBackend backend_;
+};
+
+#endif
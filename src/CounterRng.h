@@ -0,0 +1,96 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Lets device code draw the same streams.
+#if defined(__CUDACC__)
+#define AR_HOST_DEVICE __host__ __device__
+#else
+#define AR_HOST_DEVICE
+#endif
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11).
+//
+// Output is a pure function of (key, counter): stream 'stream' of seed 'seed'
+// yields the same numbers no matter which thread draws them, or in which
+// order, and any position can be reached directly without stepping.
+class CounterRng {
+public:
+    AR_HOST_DEVICE CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key0_(static_cast<std::uint32_t>(seed)),
+          key1_(static_cast<std::uint32_t>(seed >> 32)),
+          stream_(stream)
+    {
+    }
+
+    // Four 32-bit words for block 'counter' of this stream.
+    AR_HOST_DEVICE void block(std::uint64_t counter, std::uint32_t out[4]) const {
+        std::uint32_t c0 = static_cast<std::uint32_t>(counter);
+        std::uint32_t c1 = static_cast<std::uint32_t>(counter >> 32);
+        std::uint32_t c2 = static_cast<std::uint32_t>(stream_);
+        std::uint32_t c3 = static_cast<std::uint32_t>(stream_ >> 32);
+        std::uint32_t k0 = key0_, k1 = key1_;
+        for (int round = 0; round < 10; ++round) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * c0;
+            std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c2;
+            std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<std::uint32_t>(p1);
+            c3 = static_cast<std::uint32_t>(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    // Two uniforms in (0, 1) with 53-bit resolution from block 'counter'.
+    AR_HOST_DEVICE void uniforms(std::uint64_t counter, double& u0, double& u1) const {
+        std::uint32_t w[4];
+        block(counter, w);
+        u0 = toUnit((static_cast<std::uint64_t>(w[0]) << 32) | w[1]);
+        u1 = toUnit((static_cast<std::uint64_t>(w[2]) << 32) | w[3]);
+    }
+
+    // Fill out[0..n) with standard normals; normals 2j and 2j+1 come from
+    // block first + j via Box-Muller, without a rejection branch. The
+    // uniforms are drawn in one pass and transformed in a second; both stay
+    // scalar (the transform calls std::log, std::sin and std::cos).
+    void normals(std::uint64_t first, double* out, std::size_t n) const {
+        std::size_t pairs = n / 2;
+        for (std::size_t j = 0; j < pairs; ++j) {
+            uniforms(first + j, out[2 * j], out[2 * j + 1]);
+        }
+        const double twoPi = 6.28318530717958647692;
+        for (std::size_t j = 0; j < pairs; ++j) {
+            double r = std::sqrt(-2.0 * std::log(out[2 * j]));
+            double theta = twoPi * out[2 * j + 1];
+            out[2 * j] = r * std::cos(theta);
+            out[2 * j + 1] = r * std::sin(theta);
+        }
+        if (n & 1) {
+            double u0, u1;
+            uniforms(first + pairs, u0, u1);
+            out[n - 1] = std::sqrt(-2.0 * std::log(u0)) * std::cos(twoPi * u1);
+        }
+    }
+
+private:
+    AR_HOST_DEVICE static double toUnit(std::uint64_t bits) {
+        // (k + 0.5) / 2^53 for the top 53 bits: never 0 or 1.
+        return (static_cast<double>(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    std::uint32_t key0_;
+    std::uint32_t key1_;
+    std::uint64_t stream_;
+};
+
+#endif
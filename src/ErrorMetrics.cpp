@@ -0,0 +1,26 @@
+#include "ErrorMetrics.h"
+#include "Trace.h"
+#include <cmath>
+
+ErrorMetrics computeErrors(const std::vector<double>& forecast, const std::vector<double>& actual) {
+    if (forecast.size() != actual.size()) return ErrorMetrics {0.0, 0.0, 0.0};
+    return computeErrors(forecast.data(), actual.data(), forecast.size());
+}
+
+ErrorMetrics computeErrors(const double* forecast, const double* actual, std::size_t n) {
+    AR_TRACE_SCOPE("error_metrics");
+    ErrorAccumulator acc;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc.add(forecast[i], actual[i]);
+    }
+    return acc.metrics();
+}
+
+ErrorMetrics ErrorAccumulator::metrics() const {
+    ErrorMetrics em {0.0, 0.0, 0.0};
+    if (count == 0) return em;
+    em.mse = sumSq / count;
+    em.rmse = std::sqrt(em.mse);
+    em.mape = sumAbsPct / count;
+    return em;
+}
@@ -0,0 +1,39 @@
+#ifndef ERROR_METRICS_H
+#define ERROR_METRICS_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Structure for error metrics.
+struct ErrorMetrics {
+    double mse;
+    double rmse;
+    double mape;
+};
+
+// Streaming form of computeErrors(): feed (forecast, actual) pairs one at a
+// time, e.g. straight from a forecasting loop, with no intermediate vectors.
+struct ErrorAccumulator {
+    double sumSq = 0.0;
+    double sumAbsPct = 0.0;
+    std::size_t count = 0;
+
+    void add(double forecast, double actual) {
+        double diff = forecast - actual;
+        sumSq += diff * diff;
+        if (actual != 0.0)
+            sumAbsPct += std::fabs(diff / actual) * 100.0;
+        ++count;
+    }
+
+    // All zeros if nothing was added.
+    ErrorMetrics metrics() const;
+};
+
+// MSE, RMSE and MAPE (in percent) of 'forecast' against 'actual'. Returns all
+// zeros if the sizes differ or the inputs are empty.
+ErrorMetrics computeErrors(const std::vector<double>& forecast, const std::vector<double>& actual);
+ErrorMetrics computeErrors(const double* forecast, const double* actual, std::size_t n);
+
+#endif
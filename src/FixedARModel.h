@@ -0,0 +1,236 @@
+#ifndef FIXED_AR_MODEL_H
+#define FIXED_AR_MODEL_H
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ARModel.h"
+#include "ARWorkspace.h"
+#include "Autocorrelation.h"
+#include "SeriesView.h"
+
+// AR model whose order P is a compile-time constant.
+//
+// Coefficients and the forecast window live in std::array<double, P>, and the
+// Levinson-Durbin recursion, the prediction dot product and the window shift
+// are expanded at compile time, so for small P the whole multi-step forecast
+// runs in registers. The interface mirrors ARModel, and the recursion performs
+// the same operations in the same order, so coefficients match ARModel's
+// bit for bit. Predictions are summed sequentially (like the scalar
+// SimdKernels::dot), so for any P that reaches a SIMD dot's vector body (4
+// terms on AVX2, 8 on AVX-512) forecasts can differ from ARModel's in the
+// last few ulp.
+//
+// Use withFixedOrder() to dispatch a runtime order to one of the
+// precompiled sizes and fall back to ARModel otherwise.
+template <int P>
+class FixedARModel {
+    static_assert(P >= 1, "FixedARModel needs an order of at least 1");
+
+public:
+    typedef std::array<double, P> Coefficients;
+
+    static constexpr int kOrder = P;
+
+    // Keeps its own copy of the series, like ARModel(const vector&, int).
+    explicit FixedARModel(const std::vector<double>& data)
+        : ownedData_(data), data_(ownedData_), owning_(true) {}
+
+    // Zero-copy: 'data' must outlive the model.
+    explicit FixedARModel(SeriesView data)
+        : data_(data), owning_(false) {}
+
+    FixedARModel(const FixedARModel& other)
+        : ownedData_(other.ownedData_),
+          data_(other.owning_ ? SeriesView(ownedData_) : other.data_),
+          owning_(other.owning_),
+          acfMethod_(other.acfMethod_),
+          coefficients_(other.coefficients_),
+          reversedCoefficients_(other.reversedCoefficients_),
+          errorVariance_(other.errorVariance_) {}
+
+    FixedARModel& operator=(const FixedARModel& other) {
+        if (this != &other) {
+            FixedARModel copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    FixedARModel(FixedARModel&&) = default;
+    FixedARModel& operator=(FixedARModel&&) = default;
+
+    bool computeCoefficients() {
+        ARWorkspace ws;
+        return computeCoefficients(ws);
+    }
+
+    // Autocorrelation scratch comes from 'ws'; the recursion itself uses
+    // only stack arrays.
+    bool computeCoefficients(ARWorkspace& ws) {
+        if (data_.size() < static_cast<std::size_t>(P)) {
+            std::cerr << "Not enough data to compute AR coefficients.\n";
+            return false;
+        }
+        Autocorrelation::compute(data_.data(), data_.size(), P, ws.autocorrelation, acfMethod_, &ws.acf);
+        if (!yuleWalker(ws.autocorrelation.data(), coefficients_, &errorVariance_)) {
+            return false;
+        }
+        unroll<P>([&](auto i) { reversedCoefficients_[i] = coefficients_[P - 1 - i]; });
+        return true;
+    }
+
+    // Take the AR(P) solution from a fitted path (k must equal P).
+    bool selectOrder(const LevinsonPath& path, int k) {
+        if (k != P || k > path.maxOrder) {
+            std::cerr << "Order " << k << " is not available for a fixed AR(" << P << ") model.\n";
+            return false;
+        }
+        const double* c = path.coefficientsFor(P);
+        unroll<P>([&](auto i) {
+            coefficients_[i] = c[i];
+            reversedCoefficients_[P - 1 - i] = c[i];
+        });
+        errorVariance_ = path.errorVariances[P];
+        return true;
+    }
+
+    double forwardPredict() const {
+        if (data_.size() < static_cast<std::size_t>(P)) {
+            std::cerr << "Insufficient data for one-step forward prediction.\n";
+            return 0.0;
+        }
+        return dot(reversedCoefficients_, data_.end() - P);
+    }
+
+    std::vector<double> forwardPredictSteps(int k) const {
+        std::vector<double> predictions(k);
+        if (!forwardPredictSteps(k, predictions.data())) {
+            predictions.clear();
+        }
+        return predictions;
+    }
+
+    // Recursive forecasts into out[0..k). The window is a local array that
+    // is shifted by one slot per step.
+    bool forwardPredictSteps(int k, double* out) const {
+        if (data_.size() < static_cast<std::size_t>(P)) {
+            std::cerr << "Insufficient data for multi-step prediction.\n";
+            return false;
+        }
+        Coefficients window;
+        const double* history = data_.end() - P;
+        unroll<P>([&](auto i) { window[i] = history[i]; });
+        for (int step = 0; step < k; ++step) {
+            double pred = dot(reversedCoefficients_, window.data());
+            unroll<P - 1>([&](auto i) { window[i] = window[i + 1]; });
+            window[P - 1] = pred;
+            out[step] = pred;
+        }
+        return true;
+    }
+
+    // Same signature as ARModel; nothing in 'ws' is needed here.
+    bool forwardPredictSteps(int k, double* out, ARWorkspace&) const {
+        return forwardPredictSteps(k, out);
+    }
+
+    // Levinson-Durbin for order P from autocorrelations r[0..P].
+    static bool yuleWalker(const double* r, Coefficients& coefficients, double* errorVariance = nullptr) {
+        std::array<double, P + 1> a{};
+        std::array<double, P + 1> e{};
+        a[0] = 1.0;
+        e[0] = r[0];
+        if (r[0] == 0.0) {
+            std::cerr << "Zero lag autocorrelation. Cannot compute coefficients.\n";
+            return false;
+        }
+
+        unroll<P>([&](auto km1) {
+            constexpr int k = decltype(km1)::value + 1;
+            double lambda = 0.0;
+            unroll<k - 1>([&](auto jm1) {
+                constexpr int j = decltype(jm1)::value + 1;
+                lambda += a[j] * r[k - j];
+            });
+            lambda = (r[k] - lambda) / e[k - 1];
+
+            a[k] = lambda;
+            // In place, in the same order as ARModel, so the two agree exactly.
+            unroll<k - 1>([&](auto jm1) {
+                constexpr int j = decltype(jm1)::value + 1;
+                a[j] -= lambda * a[k - j];
+            });
+            e[k] = e[k - 1] * (1.0 - lambda * lambda);
+        });
+
+        unroll<P>([&](auto i) { coefficients[i] = a[i + 1]; });
+        if (errorVariance) *errorVariance = e[P];
+        return true;
+    }
+
+    void setAutocorrelationMethod(AutocorrelationMethod method) { acfMethod_ = method; }
+
+    bool ownsData() const { return owning_; }
+    SeriesView data() const { return data_; }
+
+    const Coefficients& getCoefficients() const { return coefficients_; }
+    int getOrder() const { return P; }
+    double getErrorVariance() const { return errorVariance_; }
+
+private:
+    std::vector<double> ownedData_;
+    SeriesView data_;
+    bool owning_;
+    AutocorrelationMethod acfMethod_ = AutocorrelationMethod::Automatic;
+    Coefficients coefficients_{};
+    Coefficients reversedCoefficients_{}; // phi_P..phi_1, matches an oldest-first window
+    double errorVariance_ = 0.0;
+
+    // Call f(std::integral_constant<int, i>) for i = 0..N-1, expanded inline.
+    template <int N, class F>
+    static void unroll(F&& f) {
+        unrollImpl(f, std::make_integer_sequence<int, N>());
+    }
+
+    template <class F, int... I>
+    static void unrollImpl(F& f, std::integer_sequence<int, I...>) {
+        (void)f;
+        (f(std::integral_constant<int, I>()), ...);
+    }
+
+    static double dot(const Coefficients& c, const double* x) {
+        double sum = 0.0;
+        unroll<P>([&](auto i) { sum += c[i] * x[i]; });
+        return sum;
+    }
+};
+
+// Orders with a precompiled FixedARModel.
+typedef std::integer_sequence<int, 1, 2, 5, 10, 20> FixedAROrders;
+
+namespace detail {
+
+template <class F, int... P>
+bool withFixedOrderImpl(int order, F& f, std::integer_sequence<int, P...>) {
+    return ((order == P ? (f(std::integral_constant<int, P>()), true) : false) || ...);
+}
+
+} // namespace detail
+
+// If 'order' is one of FixedAROrders, call f(std::integral_constant<int, P>)
+// and return true; otherwise return false so the caller can use ARModel:
+//
+//   bool done = withFixedOrder(p, [&](auto order) {
+//       FixedARModel<decltype(order)::value> model(series);
+//       ...
+//   });
+template <class F>
+bool withFixedOrder(int order, F&& f) {
+    return detail::withFixedOrderImpl(order, f, FixedAROrders());
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "GpuBackend.h"
+#include <atomic>
+#include <iostream>
+
+void GpuBackend::warnFallback(const char* what) {
+    static std::atomic<bool> warned(false);
+    if (warned.exchange(true)) return;
+    std::cerr << what << ": CUDA backend unavailable (not part of this build); using the CPU engine.\n";
+}
+
+// No device implementation yet: every entry point reports "unavailable".
+
+bool GpuBackend::compiledIn() {
+    return false;
+}
+
+bool GpuBackend::available() {
+    return false;
+}
+
+std::string GpuBackend::deviceName() {
+    return std::string();
+}
+
+bool GpuBackend::fitBatch(const BasicSeriesCollection<double>&, int, BatchFitResult&) {
+    return false;
+}
+
+bool GpuBackend::fitBatch(const BasicSeriesCollection<float>&, int, BatchFitResult&) {
+    return false;
+}
+
+bool GpuBackend::simulatePaths(const GpuPathJob&, double*, double*, std::uint32_t*) {
+    return false;
+}
@@ -0,0 +1,67 @@
+#ifndef GPU_BACKEND_H
+#define GPU_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+template <class T>
+struct BasicSeriesCollection;
+struct BatchFitResult;
+
+// Engine behind BatchFitter::fitBatch() and MonteCarloForecaster::simulate().
+// Cuda falls back to the CPU engine (with one warning) while no device
+// backend is available (see GpuBackend).
+enum class ComputeBackend { Cpu, Cuda };
+
+// One Monte Carlo run for the device: the same model, noise streams and
+// histogram placement as the CPU engine in MonteCarloForecaster.cpp.
+struct GpuPathJob {
+    const double* phi = nullptr;     // phi_1..phi_p
+    int order = 0;
+    double sigma = 0.0;              // innovation standard deviation
+    const double* history = nullptr; // last 'order' values, oldest first
+    std::size_t paths = 0;
+    std::size_t horizon = 0;
+    std::uint64_t seed = 0;
+    bool integrated = false;
+    double lastLevel = 0.0;
+    const double* center = nullptr;  // per step: expected path
+    const double* spread = nullptr;  // per step: histogram half-width
+    int bins = 0;
+    std::size_t blockPaths = 0;      // paths per moment block
+};
+
+// Seam for a CUDA offload of batch fits and Monte Carlo paths. The device
+// implementation is not part of this tree until it has been built with nvcc
+// and passed the gpu_backend test on a CUDA host, so compiledIn() and
+// available() are false and every entry point returns false.
+//
+// A device implementation must match the CPU engine to rounding: batch-fit
+// coefficients within 1e-9 of ARModel::computeCoefficients(), and simulated
+// paths drawn from the same CounterRng streams, with the moment sums per
+// block of blockPaths paths so MonteCarloForecaster reduces them in block
+// order.
+//
+// Every entry point returns false when the device path is unavailable or
+// fails, leaving the caller to run the CPU engine.
+class GpuBackend {
+public:
+    static bool compiledIn();
+    // Compiled in and at least one CUDA device usable.
+    static bool available();
+    // Name of the device in use, or empty.
+    static std::string deviceName();
+
+    static bool fitBatch(const BasicSeriesCollection<double>& collection, int order, BatchFitResult& out);
+    static bool fitBatch(const BasicSeriesCollection<float>& collection, int order, BatchFitResult& out);
+
+    // sums, sumSqs: (paths / blockPaths rounded up) * horizon, block-major,
+    // of deviations from job.center. counts: horizon * bins histogram counts.
+    static bool simulatePaths(const GpuPathJob& job, double* sums, double* sumSqs, std::uint32_t* counts);
+
+    // Print the CPU fallback warning once per process.
+    static void warnFallback(const char* what);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "HorizonForecaster.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <iostream>
+
+HorizonForecaster::HorizonForecaster(const std::vector<double>& coefficients, double innovationVariance,
+                                     bool integrated)
+    : sigma2_(innovationVariance)
+{
+    if (!integrated) {
+        phi_ = coefficients;
+    } else {
+        // (1 - sum phi_i L^i)(1 - L): theta_1 = 1 + phi_1,
+        // theta_i = phi_i - phi_(i-1), theta_(p+1) = -phi_p.
+        const std::size_t p = coefficients.size();
+        phi_.assign(p + 1, 0.0);
+        phi_[0] = 1.0;
+        for (std::size_t i = 0; i < p; ++i) {
+            phi_[i] += coefficients[i];
+            phi_[i + 1] -= coefficients[i];
+        }
+    }
+    psi_.push_back(1.0);
+    cumPsiSq_.push_back(0.0);
+}
+
+void HorizonForecaster::extendPsi(int horizon) {
+    const std::size_t q = phi_.size();
+    const std::size_t target = static_cast<std::size_t>(horizon);
+    // psi_j = sum_{i=1}^{min(j,q)} phi_i * psi_(j-i)
+    while (psi_.size() < target) {
+        std::size_t j = psi_.size();
+        double v = 0.0;
+        for (std::size_t i = 1; i <= std::min(j, q); ++i) {
+            v += phi_[i - 1] * psi_[j - i];
+        }
+        psi_.push_back(v);
+    }
+    while (cumPsiSq_.size() <= target) {
+        std::size_t h = cumPsiSq_.size();
+        cumPsiSq_.push_back(cumPsiSq_[h - 1] + psi_[h - 1] * psi_[h - 1]);
+    }
+}
+
+void HorizonForecaster::mulMod(const std::vector<double>& a, const std::vector<double>& b,
+                               std::vector<double>& out) const {
+    const std::size_t q = phi_.size();
+    product_.assign(2 * q - 1, 0.0);
+    for (std::size_t i = 0; i < q; ++i) {
+        if (a[i] == 0.0) continue;
+        for (std::size_t j = 0; j < q; ++j) {
+            product_[i + j] += a[i] * b[j];
+        }
+    }
+    // Reduce with z^q = sum_i phi_i z^(q-i), highest degree first.
+    for (std::size_t k = 2 * q - 2; k >= q; --k) {
+        double c = product_[k];
+        if (c == 0.0) continue;
+        for (std::size_t i = 1; i <= q; ++i) {
+            product_[k - i] += c * phi_[i - 1];
+        }
+    }
+    out.assign(product_.begin(), product_.begin() + q);
+}
+
+bool HorizonForecaster::weights(int h, std::vector<double>& out) const {
+    if (h < 1) {
+        std::cerr << "Forecast horizon must be at least 1.\n";
+        return false;
+    }
+    const std::size_t q = phi_.size();
+    out.assign(q, 0.0);
+    if (q == 0) return true;
+
+    // z^(q-1+h) mod Q by repeated squaring; the history is a_0..a_(q-1)
+    // oldest first, and the target is a_(q-1+h).
+    std::vector<double> base(q, 0.0);
+    if (q == 1) base[0] = phi_[0];
+    else base[1] = 1.0;
+    out[0] = 1.0;
+    std::vector<double> tmp;
+    for (unsigned long long e = static_cast<unsigned long long>(q) - 1 + h; e > 0; e >>= 1) {
+        if (e & 1) {
+            mulMod(out, base, tmp);
+            out.swap(tmp);
+        }
+        if (e > 1) {
+            mulMod(base, base, tmp);
+            base.swap(tmp);
+        }
+    }
+    return true;
+}
+
+bool HorizonForecaster::forecast(const double* history, const int* horizons, std::size_t count,
+                                 HorizonForecast* out) {
+    int maxHorizon = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (horizons[i] < 1) {
+            std::cerr << "Forecast horizon must be at least 1.\n";
+            return false;
+        }
+        maxHorizon = std::max(maxHorizon, horizons[i]);
+    }
+    extendPsi(maxHorizon);
+
+    std::vector<double> w;
+    for (std::size_t i = 0; i < count; ++i) {
+        weights(horizons[i], w);
+        out[i].horizon = horizons[i];
+        out[i].mean = SimdKernels::dot(w.data(), history, w.size());
+        out[i].variance = sigma2_ * cumPsiSq_[horizons[i]];
+    }
+    return true;
+}
+
+HorizonForecast HorizonForecaster::forecast(const double* history, int horizon) {
+    HorizonForecast result {horizon, 0.0, 0.0};
+    forecast(history, &horizon, 1, &result);
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef HORIZON_FORECASTER_H
+#define HORIZON_FORECASTER_H
+
+#include <cstddef>
+#include <vector>
+#include "ARModel.h"
+
+struct HorizonForecast {
+    int horizon;
+    double mean;     // point forecast
+    double variance; // forecast-error variance, sigma^2 * sum_{j<h} psi_j^2
+};
+
+// Direct h-step-ahead AR forecasts, without stepping through 1..h-1.
+//
+// The h-step forecast is a fixed linear combination of the last p values:
+// its weights are the coefficients of z^(p-1+h) mod Q(z), where
+// Q(z) = z^p - phi_1 z^(p-1) - ... - phi_p is the characteristic polynomial
+// of the companion matrix (exponentiation by squaring on polynomials rather
+// than on the p x p matrix, O(p^2 log h) instead of O(p^3 log h)).
+//
+// A single far horizon is cheaper this way than the O(h * p) recursion when
+// p * log2(h) is well below h (e.g. p <= 100 at h = 1000).
+//
+// The weight on the newest value is the impulse response psi_(h-1), so the
+// same recurrence gives the psi-weight table behind the error variances. The
+// table is grown on demand and cached; reaching horizon H costs O(H * p)
+// once.
+//
+// With 'integrated' set, the model describes the differences of a level
+// series: forecasts and variances are for the levels, using the equivalent
+// AR(p+1) recursion on levels, and the history must hold the last p+1
+// levels.
+class HorizonForecaster {
+public:
+    // coefficients: phi_1..phi_p. innovationVariance: sigma^2 (e[p]).
+    HorizonForecaster(const std::vector<double>& coefficients, double innovationVariance,
+                      bool integrated = false);
+
+    template <class T>
+    explicit HorizonForecaster(const BasicARModel<T>& model, bool integrated = false)
+        : HorizonForecaster(model.getCoefficients(), model.getErrorVariance(), integrated) {}
+
+    // Length of the history forecast() expects: p, or p + 1 when integrated.
+    int historyLength() const { return static_cast<int>(phi_.size()); }
+
+    // weights[0..historyLength()) such that the h-step forecast is
+    // sum_j weights[j] * history[j] (oldest first). Returns false if h < 1.
+    bool weights(int h, std::vector<double>& out) const;
+
+    // Forecasts at each of 'horizons' (any order, each >= 1) from 'history',
+    // the last historyLength() values, oldest first.
+    bool forecast(const double* history, const int* horizons, std::size_t count, HorizonForecast* out);
+
+    HorizonForecast forecast(const double* history, int horizon);
+
+private:
+    // Grow the psi table so cumulative sums up to 'horizon' are available.
+    void extendPsi(int horizon);
+
+    // out = a * b mod Q, all of degree < p.
+    void mulMod(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& out) const;
+
+    std::vector<double> phi_;        // effective AR coefficients (levels when integrated)
+    double sigma2_;
+    std::vector<double> psi_;        // psi_0, psi_1, ...
+    std::vector<double> cumPsiSq_;   // cumPsiSq_[h] = sum_{j<h} psi_j^2
+    mutable std::vector<double> product_; // mulMod scratch, degree < 2p - 1
+};
+
+#endif
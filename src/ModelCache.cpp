@@ -0,0 +1,167 @@
+#include "ModelCache.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline std::uint64_t rotl(std::uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+// Checked before the lookup: a cached deeper fit would otherwise serve any
+// order <= its own, including 0 and negative ones.
+bool validOrder(SeriesView data, int order) {
+    if (order < 1 || data.size() < static_cast<std::size_t>(order)) {
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
+    }
+    return true;
+}
+
+// xxHash64-style lane update.
+inline std::uint64_t round64(std::uint64_t acc, std::uint64_t input) {
+    acc += input * kPrime2;
+    acc = rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+// splitmix64 finalizer.
+inline std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline std::uint64_t bitsOf(double v) {
+    std::uint64_t u;
+    std::memcpy(&u, &v, sizeof(u));
+    return u;
+}
+
+} // namespace
+
+SeriesFingerprint SeriesFingerprint::of(SeriesView data) {
+    // Four independent lanes so consecutive samples do not serialize.
+    std::uint64_t v[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    const double* x = data.data();
+    const std::size_t n = data.size();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v[0] = round64(v[0], bitsOf(x[i]));
+        v[1] = round64(v[1], bitsOf(x[i + 1]));
+        v[2] = round64(v[2], bitsOf(x[i + 2]));
+        v[3] = round64(v[3], bitsOf(x[i + 3]));
+    }
+    for (; i < n; ++i) {
+        v[i & 3] = round64(v[i & 3], bitsOf(x[i]));
+    }
+
+    SeriesFingerprint fp;
+    fp.length = n;
+    fp.lo = mix64(rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18) + n);
+    fp.hi = mix64((v[0] ^ rotl(v[1], 29)) + (v[2] ^ rotl(v[3], 41)) + fp.lo * kPrime2);
+    return fp;
+}
+
+std::size_t ModelCache::Fit::bytes() const {
+    return sizeof(Fit) + sizeof(LruList::value_type) +
+           sizeof(double) * (autocorrelation.capacity() + path.coefficients.capacity() +
+                             path.errorVariances.capacity() + path.reflectionCoefficients.capacity());
+}
+
+ModelCache::ModelCache(std::size_t maxBytes)
+    : maxBytes_(maxBytes)
+{
+    stats_.maxBytes = maxBytes;
+}
+
+ModelCache::FitPtr ModelCache::find(const Key& key, int order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end() || it->second->second->path.maxOrder < order) {
+        ++stats_.misses;
+        return FitPtr();
+    }
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+ModelCache::FitPtr ModelCache::fitAndInsert(const Key& key, SeriesView data, int order) {
+    std::shared_ptr<Fit> fit = std::make_shared<Fit>();
+    Autocorrelation::compute(data.data(), data.size(), order, fit->autocorrelation, key.method);
+    if (!ARModel::levinsonDurbin(fit->autocorrelation, order, fit->path)) {
+        return FitPtr();
+    }
+    const std::size_t bytes = fit->bytes();
+    if (bytes > maxBytes_) return fit; // usable, but too large to keep
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        // Another thread may have cached a deeper fit in the meantime.
+        if (it->second->second->path.maxOrder >= order) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->second;
+        }
+        stats_.bytes -= it->second->second->bytes();
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+    lru_.emplace_front(key, fit);
+    index_[key] = lru_.begin();
+    stats_.bytes += bytes;
+    evictToCap();
+    return fit;
+}
+
+void ModelCache::evictToCap() {
+    while (stats_.bytes > maxBytes_ && lru_.size() > 1) {
+        const LruList::value_type& victim = lru_.back();
+        stats_.bytes -= victim.second->bytes();
+        index_.erase(victim.first);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+bool ModelCache::fit(SeriesView data, int order, CachedFit& out, AutocorrelationMethod method) {
+    if (!validOrder(data, order)) return false;
+    Key key {SeriesFingerprint::of(data), method};
+    FitPtr fit = find(key, order);
+    if (!fit) fit = fitAndInsert(key, data, order);
+    if (!fit) return false;
+
+    const double* c = fit->path.coefficientsFor(order);
+    out.order = order;
+    out.coefficients.assign(c, c + order);
+    out.autocorrelation.assign(fit->autocorrelation.begin(), fit->autocorrelation.begin() + order + 1);
+    out.errorVariance = fit->path.errorVariances[order];
+    return true;
+}
+
+bool ModelCache::computeCoefficients(ARModel& model) {
+    const int order = model.getOrder();
+    if (!validOrder(model.data(), order)) return false;
+    Key key {SeriesFingerprint::of(model.data()), model.autocorrelationMethod()};
+    FitPtr fit = find(key, order);
+    if (!fit) fit = fitAndInsert(key, model.data(), order);
+    return fit && model.selectOrder(fit->path, order);
+}
+
+ModelCacheStats ModelCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ModelCacheStats s = stats_;
+    s.entries = lru_.size();
+    return s;
+}
+
+void ModelCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    stats_.bytes = 0;
+}
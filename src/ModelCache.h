@@ -0,0 +1,114 @@
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ARModel.h"
+#include "Autocorrelation.h"
+#include "SeriesView.h"
+
+// 128-bit fingerprint of a series window (contents and length).
+struct SeriesFingerprint {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+    std::size_t length = 0;
+
+    bool operator==(const SeriesFingerprint& o) const {
+        return lo == o.lo && hi == o.hi && length == o.length;
+    }
+
+    // O(n), a few cycles per sample. Windows are told apart by fingerprint
+    // alone; the data itself is not stored or compared.
+    static SeriesFingerprint of(SeriesView data);
+};
+
+struct ModelCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;    // approximate memory held by cached fits
+    std::size_t maxBytes = 0;
+};
+
+// A cached answer for one order.
+struct CachedFit {
+    int order = 0;
+    std::vector<double> coefficients;    // phi_1..phi_order
+    std::vector<double> autocorrelation; // r[0..order]
+    double errorVariance = 0.0;
+};
+
+// Thread-safe LRU cache of AR fits, keyed by series fingerprint and
+// autocorrelation method.
+//
+// Each entry holds the autocorrelations r[0..P] and the full Levinson-Durbin
+// path up to the largest order P requested so far for that window, so any
+// order k <= P is answered without refitting. A request for a higher order
+// refits once at the new order and replaces the entry. Lower orders read from
+// the path can differ from a dedicated AR(k) fit in the last ulp, because the
+// autocorrelation kernels block their lags by maxLag.
+//
+// Fits run outside the lock; two threads missing the same window at once
+// both fit it, and the later insert wins.
+class ModelCache {
+public:
+    // maxBytes: memory cap for cached fits; least recently used entries are
+    // evicted to stay under it.
+    explicit ModelCache(std::size_t maxBytes = 64u << 20);
+
+    ModelCache(const ModelCache&) = delete;
+    ModelCache& operator=(const ModelCache&) = delete;
+
+    // Drop-in for model.computeCoefficients(): serve the model's order from
+    // the cache, fitting (and caching) the window on a miss.
+    bool computeCoefficients(ARModel& model);
+
+    // Coefficients and autocorrelations of AR(order) on 'data'. Both calls
+    // return false for order < 1 or fewer than 'order' samples, hit or miss.
+    bool fit(SeriesView data, int order, CachedFit& out,
+             AutocorrelationMethod method = AutocorrelationMethod::Automatic);
+
+    ModelCacheStats stats() const;
+    void clear();
+
+private:
+    struct Key {
+        SeriesFingerprint fingerprint;
+        AutocorrelationMethod method;
+        bool operator==(const Key& o) const { return fingerprint == o.fingerprint && method == o.method; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            return static_cast<std::size_t>(k.fingerprint.lo ^ (k.fingerprint.hi >> 1)) ^
+                   static_cast<std::size_t>(k.method);
+        }
+    };
+    // Immutable once inserted, so readers can use it after unlocking.
+    struct Fit {
+        std::vector<double> autocorrelation; // r[0..path.maxOrder]
+        LevinsonPath path;
+        std::size_t bytes() const;
+    };
+    typedef std::shared_ptr<const Fit> FitPtr;
+    typedef std::list<std::pair<Key, FitPtr> > LruList; // most recent first
+
+    // Returns the cached fit covering 'order', or a null pointer on a miss.
+    FitPtr find(const Key& key, int order);
+    // Callers have checked the order against the data.
+    FitPtr fitAndInsert(const Key& key, SeriesView data, int order);
+    void evictToCap();
+
+    mutable std::mutex mutex_;
+    LruList lru_;
+    std::unordered_map<Key, LruList::iterator, KeyHash> index_;
+    std::size_t maxBytes_;
+    ModelCacheStats stats_;
+};
+
+#endif
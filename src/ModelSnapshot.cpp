@@ -0,0 +1,158 @@
+#include "ModelSnapshot.h"
+#include "SimdKernels.h"
+#include "StreamingARModel.h"
+#include "Trace.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+std::unique_ptr<ModelSnapshot> ModelSnapshot::fromCoefficients(std::vector<double> coefficients,
+                                                               double errorVariance) {
+    std::unique_ptr<ModelSnapshot> s(new ModelSnapshot());
+    s->order = static_cast<int>(coefficients.size());
+    s->reversedCoefficients.assign(coefficients.rbegin(), coefficients.rend());
+    s->coefficients = std::move(coefficients);
+    s->errorVariance = errorVariance;
+    return s;
+}
+
+std::unique_ptr<ModelSnapshot> ModelSnapshot::fromModel(const StreamingARModel& model) {
+    if (!model.fitted()) return std::unique_ptr<ModelSnapshot>();
+    return fromCoefficients(model.getCoefficients(), model.errorVariance());
+}
+
+double ModelSnapshot::forwardPredict(const double* window) const {
+    return SimdKernels::dot(reversedCoefficients.data(), window, order);
+}
+
+void ModelSnapshot::forwardPredictSteps(const double* window, int k, double* out,
+                                        RingForecaster& forecaster) const {
+    forecaster.reset(reversedCoefficients.data(), order, window);
+    forecaster.forecast(k, out);
+}
+
+void SnapshotPublisher::Guard::release() {
+    if (slot_) slot_->store(0, std::memory_order_release);
+    slot_ = nullptr;
+    snapshot_ = nullptr;
+}
+
+SnapshotPublisher::Guard SnapshotPublisher::Reader::acquire() const {
+    if (slot_ < 0) return Guard();
+    std::atomic<std::uint64_t>& slot = publisher_->slots_[slot_].epoch;
+    // The announcement must be visible before the pointer is read: a
+    // publisher that swapped the pointer out after this load then sees the
+    // slot when it scans, and keeps the snapshot. Both stay seq_cst for that.
+    slot.store(publisher_->epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    return Guard(&slot, publisher_->current_.load(std::memory_order_seq_cst));
+}
+
+bool SnapshotPublisher::Reader::forwardPredict(const double* window, double& out) const {
+    Guard g = acquire();
+    if (!g) return false;
+    out = g->forwardPredict(window);
+    return true;
+}
+
+bool SnapshotPublisher::Reader::forwardPredictSteps(const double* window, int k, double* out,
+                                                    RingForecaster& forecaster) const {
+    Guard g = acquire();
+    if (!g) return false;
+    g->forwardPredictSteps(window, k, out, forecaster);
+    return true;
+}
+
+void SnapshotPublisher::Reader::unregister() {
+    if (slot_ >= 0) {
+        Slot& s = publisher_->slots_[slot_];
+        s.epoch.store(0, std::memory_order_release);
+        s.used.store(false, std::memory_order_release);
+    }
+    publisher_ = nullptr;
+    slot_ = -1;
+}
+
+SnapshotPublisher::SnapshotPublisher(int maxReaders)
+    : slots_(new Slot[std::max(maxReaders, 1)]), maxReaders_(std::max(maxReaders, 1)),
+      current_(nullptr), epoch_(1), version_(0)
+{
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+    // Readers must be gone by now; everything left is unreachable.
+    for (const Retired& r : retired_) delete r.snapshot;
+    delete current_.load(std::memory_order_acquire);
+}
+
+SnapshotPublisher::Reader SnapshotPublisher::registerReader() {
+    for (int i = 0; i < maxReaders_; ++i) {
+        bool expected = false;
+        if (!slots_[i].used.load(std::memory_order_relaxed) &&
+            slots_[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return Reader(this, i);
+        }
+    }
+    std::cerr << "SnapshotPublisher: all " << maxReaders_ << " reader slots in use.\n";
+    return Reader();
+}
+
+std::uint64_t SnapshotPublisher::publish(std::unique_ptr<ModelSnapshot> snapshot) {
+    AR_TRACE_SCOPE("snapshot.publish");
+    if (!snapshot) {
+        std::cerr << "SnapshotPublisher: null snapshot not published.\n";
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot->version = ++version_;
+    const ModelSnapshot* old = current_.exchange(snapshot.release(), std::memory_order_seq_cst);
+    if (old) {
+        // Readers that acquire from here on announce a later epoch and can
+        // only load the new pointer.
+        retired_.push_back(Retired {old, epoch_.fetch_add(1, std::memory_order_seq_cst)});
+    }
+    reclaimLocked();
+    return version_;
+}
+
+bool SnapshotPublisher::publish(const StreamingARModel& model) {
+    std::unique_ptr<ModelSnapshot> s = ModelSnapshot::fromModel(model);
+    if (!s) return false;
+    return publish(std::move(s)) != 0;
+}
+
+void SnapshotPublisher::reclaim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reclaimLocked();
+}
+
+void SnapshotPublisher::reclaimLocked() {
+    if (retired_.empty()) return;
+    // Oldest epoch any reader is still inside; 0 marks an idle slot.
+    std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+    for (int i = 0; i < maxReaders_; ++i) {
+        std::uint64_t e = slots_[i].epoch.load(std::memory_order_seq_cst);
+        if (e != 0) oldest = std::min(oldest, e);
+    }
+    // A snapshot replaced in epoch e can only be held by readers that
+    // announced e or earlier.
+    std::size_t kept = 0;
+    for (const Retired& r : retired_) {
+        if (r.epoch < oldest) {
+            delete r.snapshot;
+        } else {
+            retired_[kept++] = r;
+        }
+    }
+    AR_TRACE_COUNT("snapshot.reclaimed", retired_.size() - kept);
+    retired_.resize(kept);
+}
+
+std::uint64_t SnapshotPublisher::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+std::size_t SnapshotPublisher::pendingReclaim() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+}
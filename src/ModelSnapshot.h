@@ -0,0 +1,185 @@
+#ifndef MODEL_SNAPSHOT_H
+#define MODEL_SNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ARModel.h"
+#include "RingForecaster.h"
+
+class StreamingARModel;
+
+// Immutable fitted AR(p) coefficients, built once by a refit and shared by
+// every reader that acquires it. Nothing here changes after publish().
+struct ModelSnapshot {
+    std::uint64_t version = 0;                // assigned by SnapshotPublisher
+    int order = 0;
+    std::vector<double> coefficients;         // phi_1..phi_p
+    std::vector<double> reversedCoefficients; // phi_p..phi_1
+    double errorVariance = 0.0;
+
+    static std::unique_ptr<ModelSnapshot> fromCoefficients(std::vector<double> coefficients,
+                                                           double errorVariance);
+    template <class T>
+    static std::unique_ptr<ModelSnapshot> fromModel(const BasicARModel<T>& model) {
+        return fromCoefficients(model.getCoefficients(), model.getErrorVariance());
+    }
+    // Null if the streaming model has not been fitted yet.
+    static std::unique_ptr<ModelSnapshot> fromModel(const StreamingARModel& model);
+
+    // One-step prediction from the last 'order' observations, oldest first.
+    double forwardPredict(const double* window) const;
+    // k recursive forecasts into out[0..k); 'forecaster' is caller scratch.
+    void forwardPredictSteps(const double* window, int k, double* out,
+                             RingForecaster& forecaster) const;
+};
+
+// Read-copy-update publication of ModelSnapshots: a refit thread builds a new
+// snapshot off to the side and swaps it in with one atomic exchange, while
+// request threads keep predicting from whatever snapshot they acquired.
+//
+// Readers register once (one Reader per thread) and then acquire() per
+// request. Acquiring is wait-free: announce the current epoch in the reader's
+// own slot, load the snapshot pointer, and clear the slot on release; no
+// lock, no retry loop and no shared write. Replaced snapshots are retired
+// with the epoch they were replaced in and freed by a later publish() (or
+// reclaim()) once every active reader announced a newer epoch, so a reader
+// never sees its snapshot freed underneath it and a refit never waits for
+// readers. Readers slow to release only delay reclamation.
+//
+// Any number of threads may publish; publishers serialize among themselves
+// on a mutex that readers never touch.
+class SnapshotPublisher {
+public:
+    class Reader;
+
+    // RAII hold on one snapshot; valid until destroyed or released.
+    class Guard {
+    public:
+        Guard() : slot_(nullptr), snapshot_(nullptr) {}
+        Guard(Guard&& o) : slot_(o.slot_), snapshot_(o.snapshot_) { o.slot_ = nullptr; o.snapshot_ = nullptr; }
+        Guard& operator=(Guard&& o) {
+            if (this != &o) {
+                release();
+                std::swap(slot_, o.slot_);
+                std::swap(snapshot_, o.snapshot_);
+            }
+            return *this;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() { release(); }
+
+        // Null before the first publish().
+        const ModelSnapshot* get() const { return snapshot_; }
+        const ModelSnapshot* operator->() const { return snapshot_; }
+        const ModelSnapshot& operator*() const { return *snapshot_; }
+        explicit operator bool() const { return snapshot_ != nullptr; }
+
+        void release();
+
+    private:
+        friend class Reader;
+        Guard(std::atomic<std::uint64_t>* slot, const ModelSnapshot* snapshot)
+            : slot_(slot), snapshot_(snapshot) {}
+
+        std::atomic<std::uint64_t>* slot_;
+        const ModelSnapshot* snapshot_;
+    };
+
+    // One reader slot. Not thread-safe: each request thread owns one, and
+    // holds at most one Guard from it at a time.
+    class Reader {
+    public:
+        Reader() : publisher_(nullptr), slot_(-1) {}
+        Reader(Reader&& o) : publisher_(o.publisher_), slot_(o.slot_) { o.publisher_ = nullptr; o.slot_ = -1; }
+        Reader& operator=(Reader&& o) {
+            if (this != &o) {
+                unregister();
+                std::swap(publisher_, o.publisher_);
+                std::swap(slot_, o.slot_);
+            }
+            return *this;
+        }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        ~Reader() { unregister(); }
+
+        // False if the publisher ran out of reader slots.
+        bool valid() const { return slot_ >= 0; }
+
+        Guard acquire() const;
+
+        // Convenience wrappers: acquire, predict, release. Return false (and
+        // leave 'out' untouched) before the first publish().
+        bool forwardPredict(const double* window, double& out) const;
+        bool forwardPredictSteps(const double* window, int k, double* out,
+                                 RingForecaster& forecaster) const;
+
+    private:
+        friend class SnapshotPublisher;
+        Reader(SnapshotPublisher* publisher, int slot) : publisher_(publisher), slot_(slot) {}
+        void unregister();
+
+        SnapshotPublisher* publisher_;
+        int slot_;
+    };
+
+    // maxReaders: number of concurrently registered Readers.
+    explicit SnapshotPublisher(int maxReaders = 256);
+    ~SnapshotPublisher();
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Claim a reader slot; check Reader::valid().
+    Reader registerReader();
+
+    // Swap in 'snapshot' (assigning its version), retire the previous one and
+    // free whatever retired snapshots no reader can still hold. Returns the
+    // new version, or 0 (current snapshot kept) if 'snapshot' is null.
+    std::uint64_t publish(std::unique_ptr<ModelSnapshot> snapshot);
+    template <class T>
+    bool publish(const BasicARModel<T>& model) {
+        if (model.getCoefficients().empty()) return false;
+        return publish(ModelSnapshot::fromModel(model)) != 0;
+    }
+    bool publish(const StreamingARModel& model);
+
+    // Free retired snapshots that are no longer reachable by any reader.
+    void reclaim();
+
+    // Version of the current snapshot (0 before the first publish()).
+    std::uint64_t version() const;
+    // Retired snapshots still waiting for readers to move on.
+    std::size_t pendingReclaim() const;
+
+private:
+    // One cache line per reader so announcing an epoch dirties nobody else's.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch {0}; // 0: not reading
+        std::atomic<bool> used {false};
+    };
+    struct Retired {
+        const ModelSnapshot* snapshot;
+        std::uint64_t epoch; // epoch in which it was replaced
+    };
+
+    // Caller holds mutex_.
+    void reclaimLocked();
+
+    std::unique_ptr<Slot[]> slots_;
+    int maxReaders_;
+    std::atomic<const ModelSnapshot*> current_;
+    std::atomic<std::uint64_t> epoch_;
+
+    mutable std::mutex mutex_; // publishers only
+    std::vector<Retired> retired_;
+    std::uint64_t version_;
+};
+
+#endif
@@ -0,0 +1,267 @@
+#include "MonteCarloForecaster.h"
+#include "CounterRng.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void QuantileHistogram::reset(double lo, double hi, int bins) {
+    lo_ = lo;
+    width_ = (hi - lo) / bins;
+    scale_ = 1.0 / width_;
+    count_ = 0;
+    counts_.assign(bins, 0);
+}
+
+void QuantileHistogram::merge(const QuantileHistogram& other) {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+}
+
+void QuantileHistogram::addCounts(const std::uint32_t* counts) {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += counts[i];
+        count_ += counts[i];
+    }
+}
+
+double QuantileHistogram::quantile(double q) const {
+    const double target = q * static_cast<double>(count_);
+    double below = 0.0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        double c = counts_[i];
+        if (c > 0.0 && below + c >= target) {
+            return lo_ + (static_cast<double>(i) + (target - below) / c) * width_;
+        }
+        below += c;
+    }
+    return lo_ + static_cast<double>(counts_.size()) * width_;
+}
+
+MonteCarloForecaster::MonteCarloForecaster(const std::vector<double>& coefficients, double innovationVariance)
+    : phi_(coefficients), sigma_(std::sqrt(std::max(innovationVariance, 0.0)))
+{
+}
+
+namespace {
+
+const std::size_t kBlockPaths = 256; // paths advanced in lockstep
+const double kRange = 8.0;           // histogram half-width in standard deviations
+
+// Per-worker state, reused across blocks.
+struct Worker {
+    std::vector<double> ring;  // (p + 1) rows of kBlockPaths: the last p steps plus the new one
+    std::vector<double> acc;
+    std::vector<double> z0, z1;
+    std::vector<double> level;
+    std::vector<QuantileHistogram> histograms; // one per step
+};
+
+} // namespace
+
+bool MonteCarloForecaster::simulate(const double* history, const MonteCarloOptions& options,
+                                    MonteCarloForecast& out, ThreadPool* pool) const {
+    AR_TRACE_SCOPE("monte_carlo");
+    if (options.paths <= 0 || options.horizon <= 0 || options.bins < 2) {
+        std::cerr << "Monte Carlo forecast needs paths, horizon >= 1 and at least 2 bins.\n";
+        return false;
+    }
+    for (double q : options.probabilities) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            std::cerr << "Quantile probabilities must lie in [0, 1].\n";
+            return false;
+        }
+    }
+    const std::size_t p = phi_.size();
+    const std::size_t horizon = options.horizon;
+    const std::size_t paths = options.paths;
+
+    // Expected path (the noise-free recursion) and analytic standard
+    // deviation per step (psi-weights, summed once more when integrated);
+    // they place each step's histogram.
+    std::vector<double> center(horizon), spread(horizon);
+    {
+        std::vector<double> x(history, history + p);
+        x.resize(p + horizon);
+        std::vector<double> psi(horizon);
+        double level = options.lastLevel, weight = 0.0, varSum = 0.0;
+        for (std::size_t t = 0; t < horizon; ++t) {
+            double v = 0.0, w = t == 0 ? 1.0 : 0.0;
+            for (std::size_t i = 1; i <= p; ++i) {
+                v += phi_[i - 1] * x[p + t - i];
+                if (i <= t) w += phi_[i - 1] * psi[t - i];
+            }
+            x[p + t] = v;
+            psi[t] = w;
+            level += v;
+            weight = options.integrated ? weight + w : w;
+            varSum += weight * weight;
+            center[t] = options.integrated ? level : v;
+            spread[t] = kRange * sigma_ * std::sqrt(varSum);
+            if (!std::isfinite(center[t]) || !std::isfinite(spread[t])) {
+                std::cerr << "Monte Carlo forecast: the model diverges within the horizon.\n";
+                return false;
+            }
+            // Zero noise: a narrow range around the (then exact) path.
+            if (spread[t] == 0.0) spread[t] = std::max(std::fabs(center[t]) * 1e-12, 1e-300);
+        }
+    }
+
+    const std::size_t blocks = (paths + kBlockPaths - 1) / kBlockPaths;
+    // Moments relative to the expected path, per block and step.
+    std::vector<double> sums(blocks * horizon, 0.0), sumSqs(blocks * horizon, 0.0);
+    std::vector<Worker> workers(pool ? pool->concurrency() : 1);
+    const std::size_t rows = p + 1;
+
+    auto runBlocks = [&](std::size_t begin, std::size_t end, int worker) {
+        Worker& w = workers[worker];
+        if (w.histograms.empty()) {
+            w.ring.resize(rows * kBlockPaths);
+            w.acc.resize(kBlockPaths);
+            w.z0.resize(kBlockPaths);
+            w.z1.resize(kBlockPaths);
+            w.level.resize(kBlockPaths);
+            w.histograms.resize(horizon);
+            for (std::size_t t = 0; t < horizon; ++t) {
+                w.histograms[t].reset(center[t] - spread[t], center[t] + spread[t], options.bins);
+            }
+        }
+        const double sigma = sigma_;
+        for (std::size_t blk = begin; blk < end; ++blk) {
+            const std::size_t first = blk * kBlockPaths;
+            const std::size_t n = std::min(kBlockPaths, paths - first);
+            // Time s = 0..p-1 is the history, shared by all paths.
+            for (std::size_t s = 0; s < p; ++s) {
+                std::fill(w.ring.begin() + (s % rows) * kBlockPaths,
+                          w.ring.begin() + (s % rows) * kBlockPaths + n, history[s]);
+            }
+            std::fill(w.level.begin(), w.level.begin() + n, options.lastLevel);
+            double* sum = sums.data() + blk * horizon;
+            double* sumSq = sumSqs.data() + blk * horizon;
+
+            // One AR step for the block; 'noise' holds one normal per path.
+            auto step = [&](std::size_t t, const double* noise) {
+                const std::size_t s = p + t;
+                double* acc = w.acc.data();
+                std::fill(acc, acc + n, 0.0);
+                for (std::size_t i = 1; i <= p; ++i) {
+                    const double c = phi_[i - 1];
+                    const double* prev = w.ring.data() + ((s - i) % rows) * kBlockPaths;
+                    for (std::size_t b = 0; b < n; ++b) {
+                        acc[b] += c * prev[b];
+                    }
+                }
+                double* cur = w.ring.data() + (s % rows) * kBlockPaths;
+                for (std::size_t b = 0; b < n; ++b) {
+                    cur[b] = acc[b] + sigma * noise[b];
+                }
+                const double* values = cur;
+                if (options.integrated) {
+                    double* level = w.level.data();
+                    for (std::size_t b = 0; b < n; ++b) {
+                        level[b] += cur[b];
+                    }
+                    values = level;
+                }
+                // The histogram scatter stays out of the vectorized loops.
+                QuantileHistogram& hist = w.histograms[t];
+                double s1 = 0.0, s2 = 0.0;
+                for (std::size_t b = 0; b < n; ++b) {
+                    hist.add(values[b]);
+                    double d = values[b] - center[t];
+                    s1 += d;
+                    s2 += d * d;
+                }
+                sum[t] = s1;
+                sumSq[t] = s2;
+            };
+
+            const double twoPi = 6.28318530717958647692;
+            for (std::size_t t = 0; t < horizon; t += 2) {
+                // Normals t and t + 1 of every path from its block t / 2,
+                // Box-Muller as in CounterRng::normals().
+                for (std::size_t b = 0; b < n; ++b) {
+                    CounterRng(options.seed, first + b).uniforms(t / 2, w.z0[b], w.z1[b]);
+                }
+                for (std::size_t b = 0; b < n; ++b) {
+                    double r = std::sqrt(-2.0 * std::log(w.z0[b]));
+                    double theta = twoPi * w.z1[b];
+                    w.z0[b] = r * std::cos(theta);
+                    w.z1[b] = r * std::sin(theta);
+                }
+                step(t, w.z0.data());
+                if (t + 1 < horizon) step(t + 1, w.z1.data());
+            }
+        }
+    };
+    bool simulated = false;
+    if (options.backend == ComputeBackend::Cuda) {
+        AR_TRACE_SCOPE("monte_carlo.gpu");
+        GpuPathJob job;
+        job.phi = phi_.data();
+        job.order = static_cast<int>(p);
+        job.sigma = sigma_;
+        job.history = history;
+        job.paths = paths;
+        job.horizon = horizon;
+        job.seed = options.seed;
+        job.integrated = options.integrated;
+        job.lastLevel = options.lastLevel;
+        job.center = center.data();
+        job.spread = spread.data();
+        job.bins = options.bins;
+        job.blockPaths = kBlockPaths;
+        std::vector<std::uint32_t> counts(horizon * options.bins);
+        if (GpuBackend::simulatePaths(job, sums.data(), sumSqs.data(), counts.data())) {
+            Worker& w = workers[0];
+            w.histograms.resize(horizon);
+            for (std::size_t t = 0; t < horizon; ++t) {
+                w.histograms[t].reset(center[t] - spread[t], center[t] + spread[t], options.bins);
+                w.histograms[t].addCounts(counts.data() + t * options.bins);
+            }
+            simulated = true;
+        } else {
+            GpuBackend::warnFallback("Monte Carlo forecast");
+        }
+    }
+    if (!simulated && pool) {
+        pool->parallelFor(blocks, 1, runBlocks);
+    } else if (!simulated) {
+        runBlocks(0, blocks, 0);
+    }
+
+    // Merge: histogram counts are exact in any order; moments go in block order.
+    Worker* merged = nullptr;
+    for (Worker& w : workers) {
+        if (w.histograms.empty()) continue;
+        if (!merged) {
+            merged = &w;
+            continue;
+        }
+        for (std::size_t t = 0; t < horizon; ++t) merged->histograms[t].merge(w.histograms[t]);
+    }
+
+    const std::size_t q = options.probabilities.size();
+    out.horizon = options.horizon;
+    out.paths = options.paths;
+    out.probabilities = options.probabilities;
+    out.quantiles.resize(horizon * q);
+    out.mean.resize(horizon);
+    out.variance.resize(horizon);
+    const double count = static_cast<double>(paths);
+    for (std::size_t t = 0; t < horizon; ++t) {
+        double s1 = 0.0, s2 = 0.0;
+        for (std::size_t blk = 0; blk < blocks; ++blk) {
+            s1 += sums[blk * horizon + t];
+            s2 += sumSqs[blk * horizon + t];
+        }
+        out.mean[t] = center[t] + s1 / count;
+        out.variance[t] = paths > 1 ? std::max(0.0, (s2 - s1 * s1 / count) / (count - 1.0)) : 0.0;
+        for (std::size_t j = 0; j < q; ++j) {
+            out.quantiles[t * q + j] = merged->histograms[t].quantile(options.probabilities[j]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#ifndef MONTE_CARLO_FORECASTER_H
+#define MONTE_CARLO_FORECASTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ARModel.h"
+#include "GpuBackend.h"
+#include "ThreadPool.h"
+
+// Fixed-range, equal-width histogram used as a streaming quantile sketch:
+// O(1) insertion, O(bins) memory, and merging is exact (counts add), so the
+// estimate does not depend on how the samples were split among threads.
+// Values outside [lo, hi) are counted in the edge bins. Quantiles are
+// interpolated linearly within a bin, so they are accurate to about one bin
+// width.
+class QuantileHistogram {
+public:
+    QuantileHistogram() {}
+    QuantileHistogram(double lo, double hi, int bins) { reset(lo, hi, bins); }
+
+    void reset(double lo, double hi, int bins);
+
+    void add(double x) {
+        double pos = (x - lo_) * scale_;
+        std::size_t i = 0;
+        if (pos >= static_cast<double>(counts_.size() - 1)) {
+            i = counts_.size() - 1;
+        } else if (pos > 0.0) {
+            i = static_cast<std::size_t>(pos);
+        }
+        ++counts_[i];
+        ++count_;
+    }
+
+    // Requires the same range and bin count.
+    void merge(const QuantileHistogram& other);
+    // Add counts binned elsewhere (e.g. on the device) over the same bins.
+    void addCounts(const std::uint32_t* counts);
+
+    std::uint64_t count() const { return count_; }
+    // Value below which a fraction q in [0, 1] of the samples lies.
+    double quantile(double q) const;
+
+private:
+    double lo_ = 0.0;
+    double width_ = 1.0;
+    double scale_ = 1.0; // 1 / width_
+    std::uint64_t count_ = 0;
+    std::vector<std::uint32_t> counts_;
+};
+
+struct MonteCarloOptions {
+    int paths = 10000;
+    int horizon = 1;
+    std::vector<double> probabilities {0.05, 0.5, 0.95};
+    std::uint64_t seed = 1;
+    // Histogram bins per step, spanning +-8 analytic standard deviations
+    // around the expected path.
+    int bins = 2048;
+    // With 'integrated', the model describes differences and each path's
+    // steps are summed onto 'lastLevel', so the distribution is of levels.
+    bool integrated = false;
+    double lastLevel = 0.0;
+    // Cuda hands the paths to GpuBackend::simulatePaths, falling back to the
+    // CPU engine while no device backend is available.
+    ComputeBackend backend = ComputeBackend::Cpu;
+};
+
+// Per-step distribution of the simulated paths. Row t of 'quantiles' (one
+// value per probability) belongs to step t + 1.
+struct MonteCarloForecast {
+    int horizon = 0;
+    int paths = 0;
+    std::vector<double> probabilities;
+    std::vector<double> quantiles; // horizon * probabilities.size()
+    std::vector<double> mean;      // sample mean per step
+    std::vector<double> variance;  // sample variance per step
+
+    const double* quantilesAt(int step) const { return quantiles.data() + step * probabilities.size(); }
+};
+
+// Distributional AR forecasts by simulation: each path follows
+// x[t] = sum_i phi_i x[t-i] + sigma z[t] with sigma^2 the fitted innovation
+// variance (e[p]) and z[t] standard normal.
+//
+// Paths are advanced in lockstep, a block at a time, with the block's state
+// stored structure-of-arrays: the value at one time step for all paths of
+// the block is one contiguous row, so each AR term is a vectorizable
+// multiply-add across paths. Blocks run in parallel on 'pool' (optional).
+//
+// Path k draws its noise from CounterRng(seed, k) exactly as
+// CounterRng::normals(0, z, horizon) would, so every path is reproducible on
+// its own. Every step's values stream into a QuantileHistogram and moment
+// sums, per block, reduced in block order: nothing is stored per path, and
+// the result is bitwise the same for any pool size.
+class MonteCarloForecaster {
+public:
+    // coefficients: phi_1..phi_p. innovationVariance: sigma^2 (e[p]).
+    MonteCarloForecaster(const std::vector<double>& coefficients, double innovationVariance);
+
+    template <class T>
+    explicit MonteCarloForecaster(const BasicARModel<T>& model)
+        : MonteCarloForecaster(model.getCoefficients(), model.getErrorVariance()) {}
+
+    int order() const { return static_cast<int>(phi_.size()); }
+
+    // history: the last order() values of the modelled series, oldest first.
+    bool simulate(const double* history, const MonteCarloOptions& options, MonteCarloForecast& out,
+                  ThreadPool* pool = nullptr) const;
+
+private:
+    std::vector<double> phi_;
+    double sigma_;
+};
+
+#endif
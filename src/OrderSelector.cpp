@@ -0,0 +1,190 @@
+#include "OrderSelector.h"
+#include "RingForecaster.h"
+#include "Trace.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+OrderSelector::OrderSelector(int threads)
+    : pool_(threads)
+{
+}
+
+OrderSelectionResult OrderSelector::select(const LevinsonPath& path, SeriesView history, double lastLevel,
+                                           SeriesView actual, const OrderSelectionOptions& options) {
+    OrderSelectionResult result;
+    int minOrder = std::max(1, options.minOrder);
+    int maxOrder = std::min(options.maxOrder, path.maxOrder);
+    if (history.size() < static_cast<std::size_t>(maxOrder)) {
+        // Reported here rather than per order from the pool's workers.
+        std::cerr << "Insufficient data for multi-step prediction beyond order " << history.size() << ".\n";
+        maxOrder = static_cast<int>(history.size());
+    }
+    if (maxOrder < minOrder) return result;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::size_t horizon = actual.size();
+    const std::size_t total = maxOrder - minOrder + 1;
+    std::vector<OrderEvaluation> evals(total);
+
+    const bool keep = options.keepBestForecast;
+
+    // Per-worker state, reused across orders: the forecaster, the current
+    // order's forecast and the best forecast this worker has seen.
+    struct Worker {
+        RingForecaster forecaster;
+        std::vector<double> reversed;
+        std::vector<double> diffs, levels;
+        std::vector<double> bestDiffs, bestLevels;
+        int bestOrder = 0;
+        double bestMse = std::numeric_limits<double>::infinity();
+    };
+    // Without keepBestForecast, diffs and levels only hold the current block.
+    const std::size_t kBlock = 256;
+    std::vector<Worker> workers(pool_.concurrency());
+    for (Worker& w : workers) {
+        w.forecaster.reserve(maxOrder);
+        w.reversed.reserve(maxOrder);
+        w.diffs.resize(keep ? horizon : std::min(horizon, kBlock));
+        w.levels.resize(w.diffs.size());
+    }
+
+    // Forecast, integrate and score order k a block at a time, so the block
+    // is still in cache for each stage.
+    auto forecastOrder = [&](int k, Worker& w, bool record, ErrorMetrics& metrics) {
+        AR_TRACE_SCOPE("forecast_integrate_evaluate");
+        const double* c = path.coefficientsFor(k);
+        w.reversed.resize(k);
+        std::reverse_copy(c, c + k, w.reversed.begin());
+        w.forecaster.reset(w.reversed.data(), k, history.end() - k);
+
+        ErrorAccumulator acc;
+        double level = lastLevel;
+        for (std::size_t i = 0; i < horizon; i += kBlock) {
+            std::size_t m = std::min(kBlock, horizon - i);
+            double* diffs = w.diffs.data() + (record ? i : 0);
+            double* levels = w.levels.data() + (record ? i : 0);
+            w.forecaster.forecast(static_cast<int>(m), diffs);
+            Transforms::integrate(diffs, m, &level, levels);
+            level = levels[m - 1];
+            for (std::size_t j = 0; j < m; ++j) {
+                acc.add(levels[j], actual[i + j]);
+            }
+        }
+        metrics = acc.metrics();
+        return true;
+    };
+
+    auto evaluate = [&](std::size_t begin, std::size_t end, int worker) {
+        Worker& w = workers[worker];
+        for (std::size_t idx = begin; idx < end; ++idx) {
+            OrderEvaluation& ev = evals[idx];
+            ev.order = minOrder + static_cast<int>(idx);
+            ev.ok = false;
+            ev.metrics = ErrorMetrics {inf, inf, inf};
+            if (!forecastOrder(ev.order, w, keep, ev.metrics)) continue;
+            ev.ok = !std::isnan(ev.metrics.mse);
+            if (!ev.ok) continue;
+            // Same ranking as the final scan: lower MSE, then lower order.
+            if (keep && (ev.metrics.mse < w.bestMse || (ev.metrics.mse == w.bestMse && ev.order < w.bestOrder))) {
+                w.bestMse = ev.metrics.mse;
+                w.bestOrder = ev.order;
+                w.bestDiffs.swap(w.diffs);
+                w.bestLevels.swap(w.levels);
+                w.diffs.resize(horizon);
+                w.levels.resize(horizon);
+            }
+        }
+    };
+
+    // Without early stopping every order is independent: one parallel pass.
+    // With it, evaluate in blocks and scan each block in order before
+    // starting the next, discarding anything past the stopping point.
+    std::size_t block = options.patience > 0 ? static_cast<std::size_t>(2 * pool_.concurrency()) : total;
+    double bestMse = inf;
+    std::size_t scanned = 0;
+    while (scanned < total && !result.stoppedEarly) {
+        std::size_t end = std::min(total, scanned + block);
+        pool_.parallelFor(end - scanned, 1, [&](std::size_t b, std::size_t e, int worker) {
+            evaluate(scanned + b, scanned + e, worker);
+        });
+        for (; scanned < end; ++scanned) {
+            const OrderEvaluation& ev = evals[scanned];
+            if (ev.ok && ev.metrics.mse < bestMse) {
+                bestMse = ev.metrics.mse;
+                result.bestOrder = ev.order;
+                result.bestMetrics = ev.metrics;
+            }
+            if (options.patience > 0 && result.bestOrder > 0 &&
+                ev.order - result.bestOrder >= options.patience) {
+                result.stoppedEarly = (scanned + 1 < total);
+                ++scanned;
+                break;
+            }
+        }
+    }
+    evals.resize(scanned);
+    result.evaluations.swap(evals);
+
+    if (keep && result.bestOrder > 0) {
+        for (Worker& w : workers) {
+            if (w.bestOrder == result.bestOrder) {
+                result.bestForecast.swap(w.bestDiffs);
+                result.bestLevels.swap(w.bestLevels);
+                break;
+            }
+        }
+        // An order past the early-stopping point can displace the winner
+        // from its worker's cache; regenerate it in that case.
+        if (result.bestForecast.empty() && horizon > 0) {
+            Worker& w = workers[0];
+            ErrorMetrics metrics;
+            forecastOrder(result.bestOrder, w, true, metrics);
+            result.bestForecast.swap(w.diffs);
+            result.bestLevels.swap(w.levels);
+        }
+    }
+    return result;
+}
+
+CriterionSelectionResult OrderSelector::selectByCriteria(const LevinsonPath& path, std::size_t sampleCount,
+                                                         int minOrder, int maxOrder) {
+    CriterionSelectionResult result;
+    minOrder = std::max(1, minOrder);
+    maxOrder = std::min(maxOrder, path.maxOrder);
+    if (maxOrder < minOrder || sampleCount < 2) return result;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double n = static_cast<double>(sampleCount);
+    const double bicPenalty = std::log(n);
+    // ln ln N is negative below N = 3; keep the HQIC penalty non-negative.
+    const double hqicPenalty = 2.0 * std::log(std::max(bicPenalty, 1.0));
+    double bestAic = inf, bestBic = inf, bestHqic = inf;
+    result.values.reserve(maxOrder - minOrder + 1);
+    for (int k = minOrder; k <= maxOrder; ++k) {
+        const double e = path.errorVariances[k];
+        CriterionValues v {k, inf, inf, inf};
+        if (e > 0.0) {
+            const double fit = n * std::log(e);
+            v.aic = fit + 2.0 * k;
+            v.bic = fit + bicPenalty * k;
+            v.hqic = fit + hqicPenalty * k;
+        }
+        if (v.aic < bestAic) {
+            bestAic = v.aic;
+            result.bestAic = k;
+        }
+        if (v.bic < bestBic) {
+            bestBic = v.bic;
+            result.bestBic = k;
+        }
+        if (v.hqic < bestHqic) {
+            bestHqic = v.hqic;
+            result.bestHqic = k;
+        }
+        result.values.push_back(v);
+    }
+    return result;
+}
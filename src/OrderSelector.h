@@ -0,0 +1,102 @@
+#ifndef ORDER_SELECTOR_H
+#define ORDER_SELECTOR_H
+
+#include <vector>
+#include "ARModel.h"
+#include "ErrorMetrics.h"
+#include "SeriesView.h"
+#include "ThreadPool.h"
+
+struct OrderSelectionOptions {
+    int minOrder = 1;
+    int maxOrder = 1;   // clamped to the fitted path's maxOrder
+    // Early termination: stop once 'patience' consecutive orders after the
+    // current best have failed to beat it (0 = evaluate every order).
+    int patience = 0;
+    // Keep the winning order's forecast in the result (no refit needed).
+    bool keepBestForecast = true;
+};
+
+// Criterion used to pick the order. ValidationMse forecasts every candidate
+// over a held-out window (select()); the information criteria only need the
+// innovation variances e[k] the fit already produced (selectByCriteria()).
+enum class OrderCriterion { ValidationMse, AIC, BIC, HQIC };
+
+// With N samples and innovation variance e[k]:
+//   AIC  = N ln e[k] + 2k
+//   BIC  = N ln e[k] + k ln N
+//   HQIC = N ln e[k] + 2k ln ln N
+// (-2 log-likelihood of a Gaussian AR(k) up to a constant, plus the penalty).
+struct CriterionValues {
+    int order;
+    double aic;
+    double bic;
+    double hqic;
+};
+
+struct CriterionSelectionResult {
+    int bestAic = 0;  // 0 if no order had a positive e[k]
+    int bestBic = 0;
+    int bestHqic = 0;
+    std::vector<CriterionValues> values; // ascending order
+
+    int bestOrder(OrderCriterion criterion) const {
+        switch (criterion) {
+        case OrderCriterion::AIC: return bestAic;
+        case OrderCriterion::BIC: return bestBic;
+        case OrderCriterion::HQIC: return bestHqic;
+        default: return 0;
+        }
+    }
+};
+
+struct OrderEvaluation {
+    int order;
+    bool ok;
+    ErrorMetrics metrics; // infinite when !ok
+};
+
+struct OrderSelectionResult {
+    int bestOrder = 0;    // 0 if no order could be evaluated
+    ErrorMetrics bestMetrics {0.0, 0.0, 0.0};
+    std::vector<OrderEvaluation> evaluations; // ascending order, up to the stopping point
+    bool stoppedEarly = false;
+    // keepBestForecast only: the best order's forecast over the horizon, as
+    // differences and integrated from lastLevel.
+    std::vector<double> bestForecast;
+    std::vector<double> bestLevels;
+};
+
+// Chooses the AR order with the lowest validation MSE.
+//
+// Every candidate order takes its coefficients from one precomputed
+// LevinsonPath. A single streaming pass per order forecasts the validation
+// horizon on the differenced series, integrates from the last observed level
+// and accumulates the errors against the actual levels; only the current
+// best forecast is kept. Orders are evaluated concurrently; the reduction always
+// scans them in ascending order (lowest MSE wins, ties go to the lower
+// order), so the result does not depend on the thread count.
+class OrderSelector {
+public:
+    explicit OrderSelector(int threads = 0);
+
+    // history: stationary (differenced) series the path was fitted on.
+    // lastLevel: last observed level, the integration starting point.
+    // actual: levels over the validation horizon.
+    OrderSelectionResult select(const LevinsonPath& path, SeriesView history, double lastLevel,
+                                SeriesView actual, const OrderSelectionOptions& options);
+
+    // AIC, BIC and HQIC for orders minOrder..maxOrder (clamped to the path)
+    // from path.errorVariances, in one O(maxOrder) scan: no forecasting.
+    // sampleCount: length of the series the path was fitted on. Lowest value
+    // wins, ties go to the lower order.
+    static CriterionSelectionResult selectByCriteria(const LevinsonPath& path, std::size_t sampleCount,
+                                                     int minOrder, int maxOrder);
+
+    ThreadPool& pool() { return pool_; }
+
+private:
+    ThreadPool pool_;
+};
+
+#endif
@@ -0,0 +1,405 @@
+#include "PanelIO.h"
+#include "SeriesIO.h"
+#include "Trace.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+const std::size_t kNamesAlign = 64;
+// Chunks smaller than this are not worth a task of their own.
+const std::size_t kMinChunkBytes = std::size_t(1) << 20;
+
+bool readFile(const std::string& filename, std::vector<char>& buffer) {
+    std::FILE* f = std::fopen(filename.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    bool ok = std::fseek(f, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(f) : -1;
+    ok = size >= 0 && std::fseek(f, 0, SEEK_SET) == 0;
+    if (ok) {
+        // Trailing NUL so the strtod fallback always stops inside the buffer.
+        buffer.resize(static_cast<std::size_t>(size) + 1);
+        ok = std::fread(buffer.data(), 1, size, f) == static_cast<std::size_t>(size);
+        buffer[size] = '\0';
+    }
+    std::fclose(f);
+    if (!ok) std::cerr << "Error reading " << filename << ".\n";
+    return ok;
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* lineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl : end;
+}
+
+bool blankLine(const char* p, const char* eol) {
+    while (p < eol && isSpace(*p)) ++p;
+    return p == eol;
+}
+
+// Clinger's fast path: a decimal with at most 19 significant digits, a
+// mantissa below 2^53 and a power of ten within 1e+-22 converts with one
+// correctly rounded multiply or divide, so it matches std::from_chars
+// exactly. Anything else (long mantissas, large exponents, inf/nan) returns
+// false and goes through the general parser.
+bool fastParse(const char*& p, const char* eol, double& value) {
+    static const double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* q = p;
+    const bool negative = q < eol && *q == '-';
+    if (negative) ++q;
+    std::uint64_t mantissa = 0;
+    int significant = 0, exponent = 0;
+    bool digits = false;
+    for (; q < eol && static_cast<unsigned>(*q - '0') < 10; ++q) {
+        if (significant == 19) return false;
+        mantissa = mantissa * 10 + (*q - '0');
+        if (mantissa) ++significant;
+        digits = true;
+    }
+    if (q < eol && *q == '.') {
+        for (++q; q < eol && static_cast<unsigned>(*q - '0') < 10; ++q) {
+            if (significant == 19) return false;
+            mantissa = mantissa * 10 + (*q - '0');
+            if (mantissa) ++significant;
+            --exponent;
+            digits = true;
+        }
+    }
+    if (!digits) return false;
+    if (q < eol && (*q == 'e' || *q == 'E')) {
+        ++q;
+        const bool negativeExp = q < eol && *q == '-';
+        if (q < eol && (*q == '-' || *q == '+')) ++q;
+        int e = 0;
+        bool expDigits = false;
+        for (; q < eol && static_cast<unsigned>(*q - '0') < 10; ++q) {
+            if (e > 1000) return false;
+            e = e * 10 + (*q - '0');
+            expDigits = true;
+        }
+        if (!expDigits) return false;
+        exponent += negativeExp ? -e : e;
+    }
+    if (mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) return false;
+    double v = static_cast<double>(mantissa);
+    v = exponent < 0 ? v / kPow10[-exponent] : v * kPow10[exponent];
+    value = negative ? -v : v;
+    p = q;
+    return true;
+}
+
+bool generalParse(const char*& p, const char* eol, double& value) {
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result r = std::from_chars(p, eol, value);
+    if (r.ec != std::errc() || r.ptr == p) return false;
+    p = r.ptr;
+#else
+    char* stop = nullptr;
+    value = std::strtod(p, &stop);
+    if (stop == p || stop > eol) return false;
+    p = stop;
+#endif
+    return true;
+}
+
+// Parse one numeric field starting at 'p' (leading blanks allowed). Empty
+// fields give NaN. On success 'p' is left on the delimiter or line end.
+bool parseField(const char*& p, const char* eol, char delimiter, double& value) {
+    while (p < eol && isSpace(*p)) ++p;
+    if (p == eol || *p == delimiter) {
+        value = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+    if (*p == '+') ++p;
+    if (!fastParse(p, eol, value) && !generalParse(p, eol, value)) return false;
+    while (p < eol && isSpace(*p)) ++p;
+    return p == eol || *p == delimiter;
+}
+
+// Split a header line into trimmed, unquoted names.
+std::vector<std::string> splitNames(const char* p, const char* eol, char delimiter) {
+    std::vector<std::string> names;
+    while (true) {
+        const char* stop = static_cast<const char*>(std::memchr(p, delimiter, eol - p));
+        if (!stop) stop = eol;
+        const char* b = p;
+        const char* e = stop;
+        while (b < e && isSpace(*b)) ++b;
+        while (e > b && isSpace(e[-1])) --e;
+        if (e - b >= 2 && *b == '"' && e[-1] == '"') {
+            ++b;
+            --e;
+        }
+        names.emplace_back(b, e);
+        if (stop == eol) break;
+        p = stop + 1;
+    }
+    return names;
+}
+
+const char* skipFields(const char* p, const char* eol, char delimiter, std::size_t count) {
+    for (std::size_t i = 0; i < count && p < eol; ++i) {
+        const char* stop = static_cast<const char*>(std::memchr(p, delimiter, eol - p));
+        p = stop ? stop + 1 : eol;
+    }
+    return p;
+}
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    std::size_t firstRow = 0;
+    std::size_t rows = 0;
+    std::size_t errorRow = 0;
+    bool ok = true;
+};
+
+bool validHeader(const PanelFileHeader& h, std::size_t fileSize) {
+    if (std::memcmp(h.magic, "ARPN", 4) != 0) {
+        std::cerr << "Not a binary panel file (bad magic).\n";
+        return false;
+    }
+    if (h.version != PanelIO::kVersion || h.headerSize != sizeof(PanelFileHeader)) {
+        std::cerr << "Unsupported binary panel version " << h.version << ".\n";
+        return false;
+    }
+    if (h.dtype != SeriesIO::Float64) {
+        std::cerr << "Unsupported binary panel dtype " << h.dtype << ".\n";
+        return false;
+    }
+    // Divide rather than multiply: crafted sizes must not wrap the total.
+    if (h.headerSize > fileSize || h.namesBytes > fileSize - h.headerSize ||
+        (h.columns != 0 &&
+         h.rows > (fileSize - h.headerSize - h.namesBytes) / sizeof(double) / h.columns)) {
+        std::cerr << "Binary panel file is truncated.\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+long Panel::find(const std::string& name) const {
+    for (std::size_t c = 0; c < names.size(); ++c) {
+        if (names[c] == name) return static_cast<long>(c);
+    }
+    return -1;
+}
+
+SeriesCollection Panel::collection() const {
+    SeriesCollection out;
+    out.series.reserve(columns());
+    for (std::size_t c = 0; c < columns(); ++c) out.add(column(c));
+    return out;
+}
+
+bool PanelIO::readCsv(const std::string& filename, Panel& out, ThreadPool* pool, char delimiter) {
+    AR_TRACE_SCOPE("io_read_csv");
+    out = Panel();
+    std::vector<char> buffer;
+    if (!readFile(filename, buffer)) return false;
+    const char* p = buffer.data();
+    const char* end = p + buffer.size() - 1;
+
+    // Header row, then the first data row to find leading non-numeric columns.
+    const char* eol = lineEnd(p, end);
+    std::vector<std::string> header = splitNames(p, eol, delimiter);
+    const char* body = eol < end ? eol + 1 : end;
+    const char* first = body;
+    while (first < end && blankLine(first, lineEnd(first, end))) first = lineEnd(first, end) + 1;
+    std::size_t skip = 0;
+    if (first < end) {
+        const char* q = first;
+        const char* firstEol = lineEnd(first, end);
+        double v;
+        while (skip < header.size()) {
+            const char* field = q;
+            if (parseField(q, firstEol, delimiter, v)) break;
+            q = skipFields(field, firstEol, delimiter, 1);
+            ++skip;
+        }
+    }
+    if (skip == header.size()) {
+        std::cerr << "No numeric columns in " << filename << ".\n";
+        return false;
+    }
+    const std::size_t cols = header.size() - skip;
+
+    // Newline-aligned chunks of the body.
+    const std::size_t bytes = static_cast<std::size_t>(end - body);
+    std::size_t chunkCount = pool ? static_cast<std::size_t>(4 * pool->concurrency()) : 1;
+    chunkCount = std::max<std::size_t>(1, std::min(chunkCount, bytes / kMinChunkBytes));
+    std::vector<Chunk> chunks(chunkCount);
+    const char* start = body;
+    for (std::size_t i = 0; i < chunkCount; ++i) {
+        const char* stop = i + 1 == chunkCount ? end : body + bytes * (i + 1) / chunkCount;
+        if (stop < start) stop = start;
+        if (stop < end) {
+            stop = lineEnd(stop, end);
+            if (stop < end) ++stop;
+        }
+        chunks[i].begin = start;
+        chunks[i].end = stop;
+        start = stop;
+    }
+
+    auto forEachChunk = [&](const ThreadPool::RangeBody& fn) {
+        if (pool) {
+            pool->parallelFor(chunkCount, 1, fn);
+        } else {
+            fn(0, chunkCount, 0);
+        }
+    };
+
+    // Pass 1: rows per chunk, then each chunk's first row.
+    forEachChunk([&](std::size_t b, std::size_t e, int) {
+        for (std::size_t i = b; i < e; ++i) {
+            std::size_t rows = 0;
+            for (const char* q = chunks[i].begin; q < chunks[i].end;) {
+                const char* qe = lineEnd(q, chunks[i].end);
+                if (!blankLine(q, qe)) ++rows;
+                q = qe + 1;
+            }
+            chunks[i].rows = rows;
+        }
+    });
+    std::size_t rows = 0;
+    for (Chunk& c : chunks) {
+        c.firstRow = rows;
+        rows += c.rows;
+    }
+
+    out.rows = rows;
+    out.names.assign(header.begin() + skip, header.end());
+    out.values.resize(cols * rows);
+    double* values = out.values.data();
+
+    // Pass 2: parse each chunk's rows into their column-major slots.
+    forEachChunk([&](std::size_t b, std::size_t e, int) {
+        for (std::size_t i = b; i < e; ++i) {
+            Chunk& chunk = chunks[i];
+            std::size_t row = chunk.firstRow;
+            for (const char* q = chunk.begin; q < chunk.end && chunk.ok;) {
+                const char* qe = lineEnd(q, chunk.end);
+                if (!blankLine(q, qe)) {
+                    const char* f = skipFields(q, qe, delimiter, skip);
+                    for (std::size_t c = 0; c < cols; ++c) {
+                        bool last = c + 1 == cols;
+                        if (!parseField(f, qe, delimiter, values[c * rows + row]) ||
+                            (last ? f != qe : f == qe)) {
+                            chunk.ok = false;
+                            chunk.errorRow = row;
+                            break;
+                        }
+                        ++f;
+                    }
+                    ++row;
+                }
+                q = qe + 1;
+            }
+        }
+    });
+    for (const Chunk& c : chunks) {
+        if (!c.ok) {
+            std::cerr << "Error parsing " << filename << ": data row " << (c.errorRow + 1)
+                      << " is malformed or has the wrong number of fields.\n";
+            out = Panel();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PanelIO::writeBinary(const std::string& filename, const Panel& panel) {
+    AR_TRACE_SCOPE("io_write");
+    std::string names;
+    for (const std::string& n : panel.names) {
+        names += n;
+        names += '\0';
+    }
+    names.resize((names.size() + kNamesAlign - 1) / kNamesAlign * kNamesAlign, '\0');
+
+    PanelFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "ARPN", 4);
+    h.version = kVersion;
+    h.dtype = SeriesIO::Float64;
+    h.headerSize = sizeof(PanelFileHeader);
+    h.rows = panel.rows;
+    h.columns = panel.columns();
+    h.namesBytes = names.size();
+
+    std::FILE* f = std::fopen(filename.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return false;
+    }
+    const std::size_t n = panel.values.size();
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 &&
+              (names.empty() || std::fwrite(names.data(), 1, names.size(), f) == names.size()) &&
+              (n == 0 || std::fwrite(panel.values.data(), sizeof(double), n, f) == n);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) std::cerr << "Error writing " << filename << ".\n";
+    return ok;
+}
+
+bool PanelIO::readBinary(const std::string& filename, Panel& out) {
+    AR_TRACE_SCOPE("io_read");
+    out = Panel();
+    std::FILE* f = std::fopen(filename.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    PanelFileHeader h;
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1;
+    long size = -1;
+    if (ok) {
+        ok = std::fseek(f, 0, SEEK_END) == 0 && (size = std::ftell(f)) >= 0 &&
+             std::fseek(f, sizeof(h), SEEK_SET) == 0;
+    }
+    if (ok) {
+        ok = validHeader(h, static_cast<std::size_t>(size));
+    }
+    std::vector<char> names;
+    if (ok) {
+        names.resize(h.namesBytes);
+        ok = names.empty() || std::fread(names.data(), 1, names.size(), f) == names.size();
+    }
+    if (ok) {
+        for (std::size_t i = 0; out.names.size() < h.columns && i < names.size();) {
+            std::size_t len = std::strlen(names.data() + i);
+            if (i + len >= names.size()) break; // unterminated name
+            out.names.emplace_back(names.data() + i, len);
+            i += len + 1;
+        }
+        ok = out.names.size() == h.columns;
+    }
+    if (ok) {
+        out.rows = h.rows;
+        out.values.resize(h.rows * h.columns);
+        ok = out.values.empty() ||
+             std::fread(out.values.data(), sizeof(double), out.values.size(), f) == out.values.size();
+    }
+    std::fclose(f);
+    if (!ok) {
+        std::cerr << "Error reading " << filename << ".\n";
+        out = Panel();
+    }
+    return ok;
+}
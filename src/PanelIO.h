@@ -0,0 +1,64 @@
+#ifndef PANEL_IO_H
+#define PANEL_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BatchFitter.h"
+#include "SeriesView.h"
+#include "ThreadPool.h"
+
+// Many aligned series (e.g. one price column per instrument) in one
+// contiguous column-major block: column c occupies
+// values[c * rows .. (c + 1) * rows), so every column is a plain SeriesView
+// and a whole panel feeds BatchFitter without per-series copies.
+struct Panel {
+    std::size_t rows = 0;
+    std::vector<std::string> names; // one per column
+    std::vector<double> values;     // columns() * rows, column-major
+
+    std::size_t columns() const { return names.size(); }
+    SeriesView column(std::size_t c) const { return SeriesView(values.data() + c * rows, rows); }
+
+    // Index of the column called 'name', or -1.
+    long find(const std::string& name) const;
+
+    // Views of every column, for BatchFitter::fitBatch(). The panel must
+    // outlive the collection.
+    SeriesCollection collection() const;
+};
+
+// Binary panel file (".arpn"): a 64-byte little-endian header, the column
+// names (each NUL-terminated, padded to a multiple of 64 bytes), then the
+// column-major float64 payload, which a single read lands in Panel::values.
+struct PanelFileHeader {
+    char magic[4];          // "ARPN"
+    std::uint16_t version;  // PanelIO::kVersion
+    std::uint16_t dtype;    // SeriesIO::Float64
+    std::uint32_t headerSize;
+    std::uint32_t reserved;
+    std::uint64_t rows;
+    std::uint64_t columns;
+    std::uint64_t namesBytes; // size of the padded names block
+    std::uint64_t reserved2[3];
+};
+
+class PanelIO {
+public:
+    static const std::uint16_t kVersion = 1;
+
+    // CSV with a header row of column names and one row per time step.
+    // Leading columns whose first value is not a number (dates, indices) are
+    // skipped; empty fields read as NaN. The file is read with one bulk read
+    // and split into newline-aligned chunks that are parsed concurrently on
+    // 'pool' (optional) with std::from_chars, each chunk writing its rows
+    // straight into the column-major panel.
+    static bool readCsv(const std::string& filename, Panel& out, ThreadPool* pool = nullptr,
+                        char delimiter = ',');
+
+    static bool writeBinary(const std::string& filename, const Panel& panel);
+    static bool readBinary(const std::string& filename, Panel& out);
+};
+
+#endif
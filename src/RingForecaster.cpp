@@ -0,0 +1,55 @@
+#include "RingForecaster.h"
+#include "SimdKernels.h"
+#include "Trace.h"
+#include <algorithm>
+
+RingForecaster::RingForecaster()
+    : coefficients_(nullptr), order_(0), head_(0)
+{
+}
+
+namespace {
+
+template <class T>
+void fillHistory(std::vector<double>& buffer, int order, const T* history) {
+    // assign() reuses existing capacity, so re-arming at the same order does not allocate.
+    buffer.assign(2 * static_cast<size_t>(order), 0.0);
+    std::copy(history, history + order, buffer.begin());
+    std::copy(history, history + order, buffer.begin() + order);
+}
+
+} // namespace
+
+void RingForecaster::reset(const double* reversedCoefficients, int order, const double* history) {
+    coefficients_ = reversedCoefficients;
+    order_ = order;
+    head_ = 0;
+    fillHistory(buffer_, order, history);
+}
+
+void RingForecaster::reset(const double* reversedCoefficients, int order, const float* history) {
+    coefficients_ = reversedCoefficients;
+    order_ = order;
+    head_ = 0;
+    fillHistory(buffer_, order, history);
+}
+
+double RingForecaster::predict() const {
+    return SimdKernels::dot(coefficients_, buffer_.data() + head_, order_);
+}
+
+void RingForecaster::push(double value) {
+    if (order_ == 0) return;
+    // Overwrite the oldest slot in both halves; the window then starts one later.
+    buffer_[head_] = value;
+    buffer_[head_ + order_] = value;
+    if (++head_ == order_) head_ = 0;
+}
+
+void RingForecaster::forecast(int k, double* out) {
+    AR_TRACE_SCOPE("forecast");
+    AR_TRACE_COUNT("forecast_steps", k);
+    for (int i = 0; i < k; ++i) {
+        out[i] = step();
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef RING_FORECASTER_H
+#define RING_FORECASTER_H
+
+#include <cstddef>
+#include <vector>
+
+// Recursive AR forecaster over a doubled circular buffer.
+//
+// The last 'order' values are stored twice, at head and head + order, so the
+// oldest-first window buffer[head .. head + order) is always contiguous. Each
+// step is one contiguous dot product with the reversed coefficients plus two
+// stores; nothing is shifted and nothing is allocated after reset().
+class RingForecaster {
+public:
+    RingForecaster();
+
+    // reversedCoefficients: phi_p..phi_1 (must outlive the forecaster).
+    // history: the last 'order' observations, oldest first.
+    void reset(const double* reversedCoefficients, int order, const double* history);
+    // Single-precision history; the forecast itself runs in double.
+    void reset(const double* reversedCoefficients, int order, const float* history);
+
+    // Pre-size the buffer so reset() up to maxOrder never allocates.
+    void reserve(int maxOrder) { buffer_.reserve(2 * static_cast<std::size_t>(maxOrder)); }
+
+    // Prediction for the next value, without advancing.
+    double predict() const;
+
+    // Append an observed (or simulated) value, dropping the oldest.
+    void push(double value);
+
+    // Predict the next value, push it, and return it.
+    double step() {
+        double pred = predict();
+        push(pred);
+        return pred;
+    }
+
+    // Write k recursive forecasts into out[0..k).
+    void forecast(int k, double* out);
+
+    // Current oldest-first window of length order().
+    const double* window() const { return buffer_.data() + head_; }
+    int order() const { return order_; }
+
+private:
+    const double* coefficients_;
+    std::vector<double> buffer_; // 2 * order_
+    int order_;
+    int head_;
+};
+
+#endif
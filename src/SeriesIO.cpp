@@ -0,0 +1,238 @@
+#include "SeriesIO.h"
+#include "Trace.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+SeriesFileHeader makeHeader(std::size_t n) {
+    SeriesFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "ARSB", 4);
+    h.version = SeriesIO::kVersion;
+    h.dtype = SeriesIO::Float64;
+    h.headerSize = sizeof(SeriesFileHeader);
+    h.length = n;
+    return h;
+}
+
+} // namespace
+
+bool SeriesIO::validHeader(const SeriesFileHeader& header, std::size_t fileSize) {
+    if (std::memcmp(header.magic, "ARSB", 4) != 0) {
+        std::cerr << "Not a binary series file (bad magic).\n";
+        return false;
+    }
+    if (header.version != kVersion || header.headerSize != sizeof(SeriesFileHeader)) {
+        std::cerr << "Unsupported binary series version " << header.version << ".\n";
+        return false;
+    }
+    if (header.dtype != Float64) {
+        std::cerr << "Unsupported binary series dtype " << header.dtype << ".\n";
+        return false;
+    }
+    // Divide rather than multiply: a crafted length must not wrap the size.
+    if (header.headerSize > fileSize ||
+        header.length > (fileSize - header.headerSize) / sizeof(double)) {
+        std::cerr << "Binary series file is truncated.\n";
+        return false;
+    }
+    return true;
+}
+
+bool SeriesIO::writeBinary(const std::string& filename, const double* data, std::size_t n) {
+    AR_TRACE_SCOPE("io_write");
+    std::FILE* f = std::fopen(filename.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return false;
+    }
+    SeriesFileHeader h = makeHeader(n);
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 &&
+              (n == 0 || std::fwrite(data, sizeof(double), n, f) == n);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) std::cerr << "Error writing " << filename << ".\n";
+    return ok;
+}
+
+bool SeriesIO::readBinary(const std::string& filename, std::vector<double>& out) {
+    AR_TRACE_SCOPE("io_read");
+    std::FILE* f = std::fopen(filename.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    SeriesFileHeader h;
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1;
+    long size = -1;
+    if (ok) {
+        ok = std::fseek(f, 0, SEEK_END) == 0 && (size = std::ftell(f)) >= 0 &&
+             std::fseek(f, sizeof(h), SEEK_SET) == 0;
+    }
+    if (ok) {
+        ok = validHeader(h, static_cast<std::size_t>(size));
+    }
+    if (ok) {
+        out.resize(h.length);
+        ok = h.length == 0 || std::fread(out.data(), sizeof(double), out.size(), f) == out.size();
+    }
+    std::fclose(f);
+    if (!ok) std::cerr << "Error reading " << filename << ".\n";
+    return ok;
+}
+
+bool SeriesIO::writeText(const std::string& filename, const std::vector<double>& data) {
+    AR_TRACE_SCOPE("io_write");
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Error opening " << filename << " for writing.\n";
+        return false;
+    }
+    for (double val : data) {
+        outFile << val << "\n";
+    }
+    return static_cast<bool>(outFile);
+}
+
+bool SeriesIO::readText(const std::string& filename, std::vector<double>& out) {
+    AR_TRACE_SCOPE("io_read");
+    std::ifstream inFile(filename);
+    if (!inFile) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    out.clear();
+    double val;
+    while (inFile >> val) {
+        out.push_back(val);
+    }
+    return inFile.eof();
+}
+
+MappedSeries::MappedSeries()
+    : base_(nullptr), bytes_(0)
+#if defined(_WIN32)
+    , file_(nullptr), mapping_(nullptr)
+#else
+    , fd_(-1)
+#endif
+{
+}
+
+MappedSeries::~MappedSeries() {
+    close();
+}
+
+MappedSeries::MappedSeries(MappedSeries&& other)
+    : MappedSeries()
+{
+    *this = std::move(other);
+}
+
+MappedSeries& MappedSeries::operator=(MappedSeries&& other) {
+    if (this != &other) {
+        close();
+        base_ = other.base_;
+        bytes_ = other.bytes_;
+        other.base_ = nullptr;
+        other.bytes_ = 0;
+#if defined(_WIN32)
+        file_ = other.file_;
+        mapping_ = other.mapping_;
+        other.file_ = nullptr;
+        other.mapping_ = nullptr;
+#else
+        fd_ = other.fd_;
+        other.fd_ = -1;
+#endif
+    }
+    return *this;
+}
+
+bool MappedSeries::open(const std::string& filename) {
+    AR_TRACE_SCOPE("io_map");
+    close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!base) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "Error mapping " << filename << ".\n";
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    base_ = base;
+    bytes_ = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error opening " << filename << " for reading.\n";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SeriesFileHeader))) {
+        ::close(fd);
+        std::cerr << "Not a binary series file: " << filename << ".\n";
+        return false;
+    }
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        std::cerr << "Error mapping " << filename << ".\n";
+        return false;
+    }
+    fd_ = fd;
+    base_ = base;
+    bytes_ = static_cast<std::size_t>(st.st_size);
+#endif
+    if (bytes_ < sizeof(SeriesFileHeader) || !SeriesIO::validHeader(header(), bytes_)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedSeries::close() {
+    if (!base_) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(base_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    CloseHandle(static_cast<HANDLE>(file_));
+    file_ = nullptr;
+    mapping_ = nullptr;
+#else
+    munmap(base_, bytes_);
+    ::close(fd_);
+    fd_ = -1;
+#endif
+    base_ = nullptr;
+    bytes_ = 0;
+}
+
+SeriesView MappedSeries::view() const {
+    if (!base_) return SeriesView();
+    const char* payload = static_cast<const char*>(base_) + header().headerSize;
+    return SeriesView(reinterpret_cast<const double*>(payload), header().length);
+}
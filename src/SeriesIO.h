@@ -0,0 +1,76 @@
+#ifndef SERIES_IO_H
+#define SERIES_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SeriesView.h"
+
+// Binary series file (".bin"): a 32-byte little-endian header followed by
+// 'length' contiguous samples. The header size keeps the payload 32-byte
+// aligned when the file is memory-mapped.
+struct SeriesFileHeader {
+    char magic[4];          // "ARSB"
+    std::uint16_t version;  // SeriesIO::kVersion
+    std::uint16_t dtype;    // SeriesIO::DType
+    std::uint32_t headerSize;
+    std::uint32_t reserved;
+    std::uint64_t length;   // number of samples
+    std::uint64_t reserved2;
+};
+
+class SeriesIO {
+public:
+    enum DType : std::uint16_t { Float64 = 1, Float32 = 2 };
+    static const std::uint16_t kVersion = 1;
+
+    // Write the whole series with one bulk write.
+    static bool writeBinary(const std::string& filename, const double* data, std::size_t n);
+    static bool writeBinary(const std::string& filename, const std::vector<double>& data) {
+        return writeBinary(filename, data.data(), data.size());
+    }
+
+    // Read a binary series into memory (copying). Prefer MappedSeries for
+    // large files.
+    static bool readBinary(const std::string& filename, std::vector<double>& out);
+
+    // Text format: one value per line (kept for debugging and plotting).
+    static bool writeText(const std::string& filename, const std::vector<double>& data);
+    static bool readText(const std::string& filename, std::vector<double>& out);
+
+    // Validate a header; 'fileSize' is the total file size in bytes.
+    static bool validHeader(const SeriesFileHeader& header, std::size_t fileSize);
+};
+
+// Read-only memory map of a binary series file. view() points straight into
+// the mapping, so an ARModel built from it reads the file with no copy; the
+// MappedSeries must outlive any model using the view.
+class MappedSeries {
+public:
+    MappedSeries();
+    ~MappedSeries();
+    MappedSeries(MappedSeries&& other);
+    MappedSeries& operator=(MappedSeries&& other);
+    MappedSeries(const MappedSeries&) = delete;
+    MappedSeries& operator=(const MappedSeries&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return base_ != nullptr; }
+    const SeriesFileHeader& header() const { return *static_cast<const SeriesFileHeader*>(base_); }
+    SeriesView view() const;
+
+private:
+    void* base_;
+    std::size_t bytes_;
+#if defined(_WIN32)
+    void* file_;
+    void* mapping_;
+#else
+    int fd_;
+#endif
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SERIES_VIEW_H
+#define SERIES_VIEW_H
+
+#include <cstddef>
+#include <vector>
+
+// Non-owning, read-only view over a contiguous series (pointer + length),
+// modelled on std::span<const T>. The viewed memory must outlive every
+// object built from the view and must not be modified or reallocated while
+// those objects are in use.
+template <class T>
+class BasicSeriesView {
+public:
+    typedef T value_type;
+
+    BasicSeriesView() : data_(nullptr), size_(0) {}
+    BasicSeriesView(const T* data, std::size_t size) : data_(data), size_(size) {}
+    BasicSeriesView(const std::vector<T>& v) : data_(v.data()), size_(v.size()) {}
+
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    T operator[](std::size_t i) const { return data_[i]; }
+
+    // Sub-range [offset, offset + count), clamped to the view.
+    BasicSeriesView slice(std::size_t offset, std::size_t count) const {
+        if (offset > size_) offset = size_;
+        if (count > size_ - offset) count = size_ - offset;
+        return BasicSeriesView(data_ + offset, count);
+    }
+
+private:
+    const T* data_;
+    std::size_t size_;
+};
+
+typedef BasicSeriesView<double> SeriesView;
+typedef BasicSeriesView<float> FloatSeriesView; // single-precision storage
+
+#endif
@@ -0,0 +1,553 @@
+#include "SimdKernels.h"
+#include <atomic>
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define AR_SIMD_X86 1
+#include <immintrin.h>
+#define AR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define AR_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define AR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+std::atomic<int> g_activeIsa(-1);
+std::atomic<bool> g_deterministic(false);
+
+// ---------------------------------------------------------------------------
+// Scalar reference kernels
+// ---------------------------------------------------------------------------
+
+// Samples are double or float; products and sums are always double.
+template <class T>
+double dotScalar(const double* a, const T* b, std::size_t n) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void dot4Scalar(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    for (int q = 0; q < 4; ++q) {
+        out[q] = dotScalar(a, b[q], n);
+    }
+}
+
+template <class T>
+double lagSumScalar(const T* x, std::size_t n, std::size_t lag, std::size_t begin, std::size_t end) {
+    double sum = 0.0;
+    for (std::size_t i = std::max(begin, lag); i < end && i < n; ++i) {
+        sum += static_cast<double>(x[i]) * x[i - lag];
+    }
+    return sum;
+}
+
+template <class T>
+void lagProductsScalar(const T* x, std::size_t n, int firstLag, int maxLag, double* out) {
+    for (int lag = firstLag; lag <= maxLag; ++lag) {
+        out[lag] = lagSumScalar(x, n, lag, 0, n);
+    }
+}
+
+// Block layout shared by all vector kernels: a block of B lags starting at L
+// keeps lane q of the accumulators for lag L+B-1-q, so that at time i all
+// lanes read the contiguous run x[i-L-B+1 .. i-L]. Times i < L+B-1 (where
+// part of the run is out of range) are summed scalar first, which keeps every
+// lane's accumulation in sequential index order.
+template <class T>
+void blockHead(const T* x, std::size_t n, std::size_t L, std::size_t B, double* tmp) {
+    for (std::size_t q = 0; q < B; ++q) {
+        tmp[q] = lagSumScalar(x, n, L + B - 1 - q, 0, L + B - 1);
+    }
+}
+
+void blockStore(std::size_t L, std::size_t B, const double* tmp, double* out) {
+    for (std::size_t q = 0; q < B; ++q) {
+        out[L + B - 1 - q] = tmp[q];
+    }
+}
+
+// Elements i in [begin, m) of out[i] = x[i + lag] - x[i]. Every vector
+// kernel below loads both operands before storing, so out == x is safe.
+void differenceScalar(const double* x, std::size_t m, std::size_t lag, std::size_t begin, double* out) {
+    for (std::size_t i = begin; i < m; ++i) {
+        out[i] = x[i + lag] - x[i];
+    }
+}
+
+#if defined(AR_SIMD_X86)
+
+bool cpuHasAvx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+bool cpuHasAvx512() {
+    return __builtin_cpu_supports("avx512f");
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA
+// ---------------------------------------------------------------------------
+
+AR_TARGET_AVX2 double hsum256(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+// Four consecutive samples widened to double.
+AR_TARGET_AVX2 inline __m256d load4(const double* p) { return _mm256_loadu_pd(p); }
+AR_TARGET_AVX2 inline __m256d load4(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+template <class T>
+AR_TARGET_AVX2 double dotAvx2(const double* a, const T* b, std::size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), load4(b + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), load4(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), load4(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), load4(b + i + 12), s3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), load4(b + i), s0);
+    }
+    double sum = hsum256(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Two vectors per product, sharing each load of a.
+AR_TARGET_AVX2 void dot4Avx2(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    __m256d s[8];
+    for (int q = 0; q < 8; ++q) s[q] = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a0 = _mm256_loadu_pd(a + i), a1 = _mm256_loadu_pd(a + i + 4);
+        for (int q = 0; q < 4; ++q) {
+            s[2 * q] = _mm256_fmadd_pd(a0, _mm256_loadu_pd(b[q] + i), s[2 * q]);
+            s[2 * q + 1] = _mm256_fmadd_pd(a1, _mm256_loadu_pd(b[q] + i + 4), s[2 * q + 1]);
+        }
+    }
+    for (int q = 0; q < 4; ++q) {
+        double sum = hsum256(_mm256_add_pd(s[2 * q], s[2 * q + 1]));
+        for (std::size_t j = i; j < n; ++j) {
+            sum += a[j] * b[q][j];
+        }
+        out[q] = sum;
+    }
+}
+
+// NV vectors of 4 lanes: a block of 4*NV lags.
+template <int NV, class T>
+AR_TARGET_AVX2 void lagBlockAvx2(const T* x, std::size_t n, std::size_t L, bool exact, double* out) {
+    const std::size_t B = 4 * NV;
+    alignas(32) double tmp[B];
+    blockHead(x, n, L, B, tmp);
+
+    __m256d acc[NV];
+    for (int v = 0; v < NV; ++v) acc[v] = _mm256_load_pd(tmp + 4 * v);
+    std::size_t i = L + B - 1;
+    if (exact) {
+        for (; i < n; ++i) {
+            const T* w = x + (i - L - (B - 1));
+            __m256d xi = _mm256_set1_pd(x[i]);
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = _mm256_add_pd(acc[v], _mm256_mul_pd(xi, load4(w + 4 * v)));
+            }
+        }
+    } else {
+        // Second accumulator set for odd i hides the FMA latency.
+        __m256d odd[NV];
+        for (int v = 0; v < NV; ++v) odd[v] = _mm256_setzero_pd();
+        for (; i + 1 < n; i += 2) {
+            const T* w = x + (i - L - (B - 1));
+            __m256d xi = _mm256_set1_pd(x[i]);
+            __m256d xj = _mm256_set1_pd(x[i + 1]);
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = _mm256_fmadd_pd(xi, load4(w + 4 * v), acc[v]);
+                odd[v] = _mm256_fmadd_pd(xj, load4(w + 4 * v + 1), odd[v]);
+            }
+        }
+        for (; i < n; ++i) {
+            const T* w = x + (i - L - (B - 1));
+            __m256d xi = _mm256_set1_pd(x[i]);
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = _mm256_fmadd_pd(xi, load4(w + 4 * v), acc[v]);
+            }
+        }
+        for (int v = 0; v < NV; ++v) acc[v] = _mm256_add_pd(acc[v], odd[v]);
+    }
+    for (int v = 0; v < NV; ++v) _mm256_store_pd(tmp + 4 * v, acc[v]);
+    blockStore(L, B, tmp, out);
+}
+
+AR_TARGET_AVX2 std::size_t differenceAvx2(const double* x, std::size_t m, std::size_t lag, double* out) {
+    std::size_t i = 0;
+    for (; i + 8 <= m; i += 8) {
+        __m256d a0 = _mm256_sub_pd(_mm256_loadu_pd(x + i + lag), _mm256_loadu_pd(x + i));
+        __m256d a1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + lag + 4), _mm256_loadu_pd(x + i + 4));
+        _mm256_storeu_pd(out + i, a0);
+        _mm256_storeu_pd(out + i + 4, a1);
+    }
+    return i;
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512F
+// ---------------------------------------------------------------------------
+
+AR_TARGET_AVX512 inline __m512d load8(const double* p) { return _mm512_loadu_pd(p); }
+AR_TARGET_AVX512 inline __m512d load8(const float* p) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+
+template <class T>
+AR_TARGET_AVX512 double dotAvx512(const double* a, const T* b, std::size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), load8(b + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), load8(b + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), load8(b + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), load8(b + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), load8(b + i), s0);
+    }
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+AR_TARGET_AVX512 void dot4Avx512(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    __m512d s[8];
+    for (int q = 0; q < 8; ++q) s[q] = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d a0 = _mm512_loadu_pd(a + i), a1 = _mm512_loadu_pd(a + i + 8);
+        for (int q = 0; q < 4; ++q) {
+            s[2 * q] = _mm512_fmadd_pd(a0, _mm512_loadu_pd(b[q] + i), s[2 * q]);
+            s[2 * q + 1] = _mm512_fmadd_pd(a1, _mm512_loadu_pd(b[q] + i + 8), s[2 * q + 1]);
+        }
+    }
+    for (int q = 0; q < 4; ++q) {
+        double sum = _mm512_reduce_add_pd(_mm512_add_pd(s[2 * q], s[2 * q + 1]));
+        for (std::size_t j = i; j < n; ++j) {
+            sum += a[j] * b[q][j];
+        }
+        out[q] = sum;
+    }
+}
+
+template <class T>
+AR_TARGET_AVX512 void lagBlockAvx512(const T* x, std::size_t n, std::size_t L, bool exact, double* out) {
+    const int NV = 4;
+    const std::size_t B = 8 * NV;
+    alignas(64) double tmp[B];
+    blockHead(x, n, L, B, tmp);
+
+    __m512d acc[NV];
+    for (int v = 0; v < NV; ++v) acc[v] = _mm512_load_pd(tmp + 8 * v);
+    for (std::size_t i = L + B - 1; i < n; ++i) {
+        const T* w = x + (i - L - (B - 1));
+        __m512d xi = _mm512_set1_pd(x[i]);
+        if (exact) {
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = _mm512_add_pd(acc[v], _mm512_mul_pd(xi, load8(w + 8 * v)));
+            }
+        } else {
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = _mm512_fmadd_pd(xi, load8(w + 8 * v), acc[v]);
+            }
+        }
+    }
+    for (int v = 0; v < NV; ++v) _mm512_store_pd(tmp + 8 * v, acc[v]);
+    blockStore(L, B, tmp, out);
+}
+
+AR_TARGET_AVX512 std::size_t differenceAvx512(const double* x, std::size_t m, std::size_t lag, double* out) {
+    std::size_t i = 0;
+    for (; i + 16 <= m; i += 16) {
+        __m512d a0 = _mm512_sub_pd(_mm512_loadu_pd(x + i + lag), _mm512_loadu_pd(x + i));
+        __m512d a1 = _mm512_sub_pd(_mm512_loadu_pd(x + i + lag + 8), _mm512_loadu_pd(x + i + 8));
+        _mm512_storeu_pd(out + i, a0);
+        _mm512_storeu_pd(out + i + 8, a1);
+    }
+    return i;
+}
+
+#endif // AR_SIMD_X86
+
+#if defined(AR_SIMD_NEON)
+
+// ---------------------------------------------------------------------------
+// NEON (AArch64)
+// ---------------------------------------------------------------------------
+
+inline float64x2_t load2(const double* p) { return vld1q_f64(p); }
+inline float64x2_t load2(const float* p) { return vcvt_f64_f32(vld1_f32(p)); }
+
+template <class T>
+double dotNeon(const double* a, const T* b, std::size_t n) {
+    float64x2_t s0 = vdupq_n_f64(0.0), s1 = vdupq_n_f64(0.0);
+    float64x2_t s2 = vdupq_n_f64(0.0), s3 = vdupq_n_f64(0.0);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = vfmaq_f64(s0, vld1q_f64(a + i), load2(b + i));
+        s1 = vfmaq_f64(s1, vld1q_f64(a + i + 2), load2(b + i + 2));
+        s2 = vfmaq_f64(s2, vld1q_f64(a + i + 4), load2(b + i + 4));
+        s3 = vfmaq_f64(s3, vld1q_f64(a + i + 6), load2(b + i + 6));
+    }
+    double sum = vaddvq_f64(vaddq_f64(vaddq_f64(s0, s1), vaddq_f64(s2, s3)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void dot4Neon(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    float64x2_t s[8];
+    for (int q = 0; q < 8; ++q) s[q] = vdupq_n_f64(0.0);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t a0 = vld1q_f64(a + i), a1 = vld1q_f64(a + i + 2);
+        for (int q = 0; q < 4; ++q) {
+            s[2 * q] = vfmaq_f64(s[2 * q], a0, vld1q_f64(b[q] + i));
+            s[2 * q + 1] = vfmaq_f64(s[2 * q + 1], a1, vld1q_f64(b[q] + i + 2));
+        }
+    }
+    for (int q = 0; q < 4; ++q) {
+        double sum = vaddvq_f64(vaddq_f64(s[2 * q], s[2 * q + 1]));
+        for (std::size_t j = i; j < n; ++j) {
+            sum += a[j] * b[q][j];
+        }
+        out[q] = sum;
+    }
+}
+
+// NV vectors of 2 lanes: a block of 2*NV lags.
+template <int NV, class T>
+void lagBlockNeon(const T* x, std::size_t n, std::size_t L, bool exact, double* out) {
+    const std::size_t B = 2 * NV;
+    alignas(16) double tmp[B];
+    blockHead(x, n, L, B, tmp);
+
+    float64x2_t acc[NV];
+    for (int v = 0; v < NV; ++v) acc[v] = vld1q_f64(tmp + 2 * v);
+    for (std::size_t i = L + B - 1; i < n; ++i) {
+        const T* w = x + (i - L - (B - 1));
+        float64x2_t xi = vdupq_n_f64(x[i]);
+        if (exact) {
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = vaddq_f64(acc[v], vmulq_f64(xi, load2(w + 2 * v)));
+            }
+        } else {
+            for (int v = 0; v < NV; ++v) {
+                acc[v] = vfmaq_f64(acc[v], xi, load2(w + 2 * v));
+            }
+        }
+    }
+    for (int v = 0; v < NV; ++v) vst1q_f64(tmp + 2 * v, acc[v]);
+    blockStore(L, B, tmp, out);
+}
+
+std::size_t differenceNeon(const double* x, std::size_t m, std::size_t lag, double* out) {
+    std::size_t i = 0;
+    for (; i + 4 <= m; i += 4) {
+        float64x2_t a0 = vsubq_f64(vld1q_f64(x + i + lag), vld1q_f64(x + i));
+        float64x2_t a1 = vsubq_f64(vld1q_f64(x + i + lag + 2), vld1q_f64(x + i + 2));
+        vst1q_f64(out + i, a0);
+        vst1q_f64(out + i + 2, a1);
+    }
+    return i;
+}
+
+#endif // AR_SIMD_NEON
+
+bool isSupported(SimdKernels::Isa isa) {
+    switch (isa) {
+    case SimdKernels::Isa::Scalar: return true;
+#if defined(AR_SIMD_X86)
+    case SimdKernels::Isa::AVX2: return cpuHasAvx2();
+    case SimdKernels::Isa::AVX512: return cpuHasAvx512();
+#endif
+#if defined(AR_SIMD_NEON)
+    case SimdKernels::Isa::NEON: return true;
+#endif
+    default: return false;
+    }
+}
+
+// Run 'block' over as many whole blocks of 'width' lags as fit, starting at
+// lag *next, and advance *next past them.
+template <class T>
+void lagProductsBlocked(const T* x, std::size_t n, int maxLag, double* out,
+                        std::size_t width, void (*block)(const T*, std::size_t, std::size_t, bool, double*),
+                        bool exact, std::size_t* next) {
+    std::size_t lag = *next;
+    for (; lag + width <= static_cast<std::size_t>(maxLag) + 1; lag += width) {
+        block(x, n, lag, exact, out);
+    }
+    *next = lag;
+}
+
+} // namespace
+
+SimdKernels::Isa SimdKernels::detectedIsa() {
+#if defined(AR_SIMD_X86)
+    static const Isa isa = cpuHasAvx512() ? Isa::AVX512 : (cpuHasAvx2() ? Isa::AVX2 : Isa::Scalar);
+    return isa;
+#elif defined(AR_SIMD_NEON)
+    return Isa::NEON;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+SimdKernels::Isa SimdKernels::activeIsa() {
+    int isa = g_activeIsa.load(std::memory_order_relaxed);
+    return isa < 0 ? detectedIsa() : static_cast<Isa>(isa);
+}
+
+void SimdKernels::setIsa(Isa isa) {
+    // Walk down from the requested ISA to the first one this CPU can run.
+    while (isa != Isa::Scalar && !isSupported(isa)) {
+        isa = static_cast<Isa>(static_cast<int>(isa) - 1);
+    }
+    g_activeIsa.store(static_cast<int>(isa), std::memory_order_relaxed);
+}
+
+const char* SimdKernels::isaName(Isa isa) {
+    switch (isa) {
+    case Isa::NEON: return "neon";
+    case Isa::AVX2: return "avx2";
+    case Isa::AVX512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+void SimdKernels::setDeterministic(bool enabled) {
+    g_deterministic.store(enabled, std::memory_order_relaxed);
+}
+
+bool SimdKernels::deterministic() {
+    return g_deterministic.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+template <class T>
+double dotDispatch(const double* a, const T* b, std::size_t n) {
+    if (SimdKernels::deterministic()) {
+        return dotScalar(a, b, n);
+    }
+    switch (SimdKernels::activeIsa()) {
+#if defined(AR_SIMD_X86)
+    case SimdKernels::Isa::AVX512: return dotAvx512(a, b, n);
+    case SimdKernels::Isa::AVX2: return dotAvx2(a, b, n);
+#endif
+#if defined(AR_SIMD_NEON)
+    case SimdKernels::Isa::NEON: return dotNeon(a, b, n);
+#endif
+    default: return dotScalar(a, b, n);
+    }
+}
+
+void dot4Dispatch(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    if (SimdKernels::deterministic()) {
+        dot4Scalar(a, b, n, out);
+        return;
+    }
+    switch (SimdKernels::activeIsa()) {
+#if defined(AR_SIMD_X86)
+    case SimdKernels::Isa::AVX512: dot4Avx512(a, b, n, out); break;
+    case SimdKernels::Isa::AVX2: dot4Avx2(a, b, n, out); break;
+#endif
+#if defined(AR_SIMD_NEON)
+    case SimdKernels::Isa::NEON: dot4Neon(a, b, n, out); break;
+#endif
+    default: dot4Scalar(a, b, n, out); break;
+    }
+}
+
+template <class T>
+void lagProductsDispatch(const T* x, std::size_t n, int maxLag, double* out) {
+    bool exact = SimdKernels::deterministic();
+    std::size_t next = 0;
+    // Wide blocks first, then narrower ones for the remaining lags, then scalar.
+    switch (SimdKernels::activeIsa()) {
+#if defined(AR_SIMD_X86)
+    case SimdKernels::Isa::AVX512:
+        lagProductsBlocked(x, n, maxLag, out, 32, lagBlockAvx512<T>, exact, &next);
+        lagProductsBlocked(x, n, maxLag, out, 16, lagBlockAvx2<4, T>, exact, &next);
+        lagProductsBlocked(x, n, maxLag, out, 4, lagBlockAvx2<1, T>, exact, &next);
+        break;
+    case SimdKernels::Isa::AVX2:
+        lagProductsBlocked(x, n, maxLag, out, 16, lagBlockAvx2<4, T>, exact, &next);
+        lagProductsBlocked(x, n, maxLag, out, 4, lagBlockAvx2<1, T>, exact, &next);
+        break;
+#endif
+#if defined(AR_SIMD_NEON)
+    case SimdKernels::Isa::NEON:
+        lagProductsBlocked(x, n, maxLag, out, 8, lagBlockNeon<4, T>, exact, &next);
+        lagProductsBlocked(x, n, maxLag, out, 2, lagBlockNeon<1, T>, exact, &next);
+        break;
+#endif
+    default:
+        break;
+    }
+    lagProductsScalar(x, n, static_cast<int>(next), maxLag, out);
+}
+
+// Subtraction is exact per element, so every ISA gives the same result.
+void differenceDispatch(const double* x, std::size_t m, std::size_t lag, double* out) {
+    std::size_t done = 0;
+    switch (SimdKernels::activeIsa()) {
+#if defined(AR_SIMD_X86)
+    case SimdKernels::Isa::AVX512: done = differenceAvx512(x, m, lag, out); break;
+    case SimdKernels::Isa::AVX2: done = differenceAvx2(x, m, lag, out); break;
+#endif
+#if defined(AR_SIMD_NEON)
+    case SimdKernels::Isa::NEON: done = differenceNeon(x, m, lag, out); break;
+#endif
+    default: break;
+    }
+    differenceScalar(x, m, lag, done, out);
+}
+
+} // namespace
+
+double SimdKernels::dot(const double* a, const double* b, std::size_t n) {
+    return dotDispatch(a, b, n);
+}
+
+double SimdKernels::dot(const double* a, const float* b, std::size_t n) {
+    return dotDispatch(a, b, n);
+}
+
+void SimdKernels::dot4(const double* a, const double* const b[4], std::size_t n, double out[4]) {
+    dot4Dispatch(a, b, n, out);
+}
+
+void SimdKernels::lagProducts(const double* x, std::size_t n, int maxLag, double* out) {
+    lagProductsDispatch(x, n, maxLag, out);
+}
+
+void SimdKernels::lagProducts(const float* x, std::size_t n, int maxLag, double* out) {
+    lagProductsDispatch(x, n, maxLag, out);
+}
+
+void SimdKernels::difference(const double* x, std::size_t n, std::size_t lag, double* out) {
+    if (lag == 0 || n <= lag) return;
+    differenceDispatch(x, n - lag, lag, out);
+}
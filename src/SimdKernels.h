@@ -0,0 +1,48 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+
+// Vectorized inner loops shared by the autocorrelation and prediction code.
+// The instruction set is chosen once at runtime (AVX-512F, AVX2+FMA, NEON or
+// scalar) and can be lowered for testing.
+class SimdKernels {
+public:
+    enum class Isa { Scalar, NEON, AVX2, AVX512 };
+
+    // Best instruction set supported by this CPU and build.
+    static Isa detectedIsa();
+    // Instruction set currently used by the kernels.
+    static Isa activeIsa();
+    // Use 'isa' if supported, otherwise the best supported one below it.
+    static void setIsa(Isa isa);
+    static const char* isaName(Isa isa);
+
+    // Deterministic summation: every ISA accumulates each sum sequentially in
+    // index order without FMA contraction, so results are deterministic across
+    // ISAs and machines. They need not match older callers' loops bit for bit:
+    // forwardPredict() sums oldest to newest, where the original loop summed
+    // newest to oldest. Off by default (faster, reassociated).
+    static void setDeterministic(bool enabled);
+    static bool deterministic();
+
+    // sum_{i<n} a[i] * b[i]
+    static double dot(const double* a, const double* b, std::size_t n);
+    // Single-precision samples, widened on load; products and sums in double.
+    static double dot(const double* a, const float* b, std::size_t n);
+    // out[q] = dot(a, b[q], n) for q < 4, sharing every load of a (a
+    // register-blocked row times four columns).
+    static void dot4(const double* a, const double* const b[4], std::size_t n, double out[4]);
+
+    // out[lag] = sum_{i=lag}^{n-1} x[i] * x[i-lag] for lag = 0..maxLag (raw,
+    // unnormalized). Lags are processed in blocks that share each load of x[i].
+    static void lagProducts(const double* x, std::size_t n, int maxLag, double* out);
+    // Same over float samples (half the memory traffic), accumulated in double.
+    static void lagProducts(const float* x, std::size_t n, int maxLag, double* out);
+
+    // out[i] = x[i + lag] - x[i] for i < n - lag. Exact, so identical on every
+    // ISA; out may equal x (in-place differencing).
+    static void difference(const double* x, std::size_t n, std::size_t lag, double* out);
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "StreamingARModel.h"
+#include "ARModel.h"
+#include "RingForecaster.h"
+#include "SimdKernels.h"
+#include <iostream>
+#include <algorithm>
+
+StreamingARModel::StreamingARModel(WindowMode mode, int order, std::size_t capacity,
+                                   double lambda, int refitInterval)
+    : mode_(mode), order_(order), capacity_(capacity), lambda_(lambda),
+      refitInterval_(refitInterval), history_(2 * capacity, 0.0), head_(0), count_(0),
+      lagSums_(order + 1, 0.0), weight_(0.0), sinceResync_(0), sinceRefit_(0),
+      fitted_(false), errorVariance_(0.0)
+{
+}
+
+StreamingARModel StreamingARModel::sliding(int order, std::size_t windowSize, int refitInterval) {
+    if (windowSize <= static_cast<std::size_t>(order)) {
+        std::cerr << "Sliding window must be longer than the AR order; using order + 1.\n";
+        windowSize = order + 1;
+    }
+    return StreamingARModel(WindowMode::Sliding, order, windowSize, 1.0, refitInterval);
+}
+
+StreamingARModel StreamingARModel::exponential(int order, double lambda, int refitInterval) {
+    if (!(lambda > 0.0 && lambda <= 1.0)) {
+        std::cerr << "Forgetting factor must be in (0, 1]; using 1.\n";
+        lambda = 1.0;
+    }
+    return StreamingARModel(WindowMode::Exponential, order, order + 1, lambda, refitInterval);
+}
+
+void StreamingARModel::push(double x) {
+    const std::size_t p = order_;
+
+    if (count_ == capacity_) {
+        const double* w = window();
+        if (mode_ == WindowMode::Sliding) {
+            // The oldest sample leaves: drop its products with w[l], l = 0..p.
+            double oldest = w[0];
+            for (std::size_t l = 0; l <= p; ++l) {
+                lagSums_[l] -= oldest * w[l];
+            }
+        }
+        // Overwrite the oldest slot in both halves of the doubled buffer.
+        history_[head_] = x;
+        history_[head_ + capacity_] = x;
+        if (++head_ == capacity_) head_ = 0;
+    } else {
+        history_[head_ + count_] = x;
+        history_[head_ + count_ + capacity_] = x;
+        ++count_;
+    }
+
+    // Products of the new sample with itself and the previous p samples.
+    const double* w = window();
+    std::size_t last = count_ - 1;
+    std::size_t lags = std::min(p, last);
+    if (mode_ == WindowMode::Exponential) {
+        for (std::size_t l = 0; l <= p; ++l) {
+            lagSums_[l] *= lambda_;
+        }
+        weight_ = lambda_ * weight_ + 1.0;
+    }
+    for (std::size_t l = 0; l <= lags; ++l) {
+        lagSums_[l] += x * w[last - l];
+    }
+
+    if (mode_ == WindowMode::Sliding && ++sinceResync_ >= capacity_) {
+        recomputeSums();
+    }
+    if (refitInterval_ > 0 && ++sinceRefit_ >= refitInterval_ && ready()) {
+        refit();
+    }
+}
+
+void StreamingARModel::recomputeSums() {
+    sinceResync_ = 0;
+    SimdKernels::lagProducts(window(), count_, order_, lagSums_.data());
+}
+
+void StreamingARModel::autocorrelation(std::vector<double>& out) const {
+    out.resize(order_ + 1);
+    double norm = (mode_ == WindowMode::Sliding) ? static_cast<double>(count_) : weight_;
+    for (int l = 0; l <= order_; ++l) {
+        out[l] = norm > 0.0 ? lagSums_[l] / norm : 0.0;
+    }
+}
+
+bool StreamingARModel::refit() {
+    sinceRefit_ = 0;
+    if (!ready()) {
+        std::cerr << "Not enough data to compute AR coefficients.\n";
+        return false;
+    }
+    autocorrelation(scratch_);
+    if (!ARModel::yuleWalker(scratch_, order_, coefficients_, &errorVariance_)) {
+        return false;
+    }
+    reversedCoefficients_.assign(coefficients_.rbegin(), coefficients_.rend());
+    fitted_ = true;
+    return true;
+}
+
+double StreamingARModel::forwardPredict() const {
+    if (!fitted_ || count_ < static_cast<std::size_t>(order_)) {
+        return 0.0;
+    }
+    return SimdKernels::dot(reversedCoefficients_.data(), window() + count_ - order_, order_);
+}
+
+std::vector<double> StreamingARModel::forwardPredictSteps(int k) const {
+    std::vector<double> predictions;
+    if (!fitted_ || count_ < static_cast<std::size_t>(order_)) {
+        std::cerr << "Insufficient data for multi-step prediction.\n";
+        return predictions;
+    }
+    predictions.resize(k);
+    RingForecaster forecaster;
+    forecaster.reset(reversedCoefficients_.data(), order_, window() + count_ - order_);
+    forecaster.forecast(k, predictions.data());
+    return predictions;
+}
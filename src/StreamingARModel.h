@@ -0,0 +1,78 @@
+#ifndef STREAMING_AR_MODEL_H
+#define STREAMING_AR_MODEL_H
+
+#include <cstddef>
+#include <vector>
+
+// Online AR(p) model with incrementally maintained lag-product sums.
+//
+// Each push() updates R[l] = sum x_t * x_{t-l} (l = 0..order) in O(order):
+//  - Sliding: exact sums over the last 'windowSize' samples; the sample that
+//    leaves the window has its products subtracted. The sums are recomputed
+//    from the buffer once per window length to bound cancellation drift, so
+//    the amortized cost stays O(order).
+//  - Exponential: R[l] <- lambda * R[l] + x_t * x_{t-l}, normalized by the
+//    running weight sum.
+// Levinson-Durbin is re-solved only by refit(), or automatically every
+// 'refitInterval' pushes when that is non-zero.
+class StreamingARModel {
+public:
+    enum class WindowMode { Sliding, Exponential };
+
+    static StreamingARModel sliding(int order, std::size_t windowSize, int refitInterval = 0);
+    static StreamingARModel exponential(int order, double lambda, int refitInterval = 0);
+
+    // Add one observation.
+    void push(double x);
+
+    // Re-solve the Yule-Walker equations from the current lag sums.
+    bool refit();
+
+    // One-step prediction from the latest coefficients and the last 'order'
+    // samples. Returns 0 before the first successful refit.
+    double forwardPredict() const;
+
+    // Multi-step recursive prediction from the current state.
+    std::vector<double> forwardPredictSteps(int k) const;
+
+    // Current normalized autocorrelations r[0..order] (biased, as in ARModel).
+    void autocorrelation(std::vector<double>& out) const;
+
+    // True once enough samples have arrived to fit and predict.
+    bool ready() const { return count_ > static_cast<std::size_t>(order_); }
+    bool fitted() const { return fitted_; }
+    std::size_t samples() const { return count_; }
+    int getOrder() const { return order_; }
+    WindowMode mode() const { return mode_; }
+    const std::vector<double>& getCoefficients() const { return coefficients_; }
+    double errorVariance() const { return errorVariance_; }
+
+private:
+    StreamingARModel(WindowMode mode, int order, std::size_t capacity, double lambda, int refitInterval);
+
+    // Oldest-first view of the retained history: history_[head_ .. head_ + count_).
+    const double* window() const { return history_.data() + head_; }
+    void recomputeSums();
+
+    WindowMode mode_;
+    int order_;
+    std::size_t capacity_;        // retained samples (window size, or order+1)
+    double lambda_;
+    int refitInterval_;
+
+    std::vector<double> history_; // doubled ring buffer, 2 * capacity_
+    std::size_t head_;
+    std::size_t count_;
+    std::vector<double> lagSums_; // R[0..order]
+    double weight_;               // exponential mode: sum of lambda^j
+    std::size_t sinceResync_;
+    int sinceRefit_;
+
+    bool fitted_;
+    std::vector<double> coefficients_;
+    std::vector<double> reversedCoefficients_;
+    std::vector<double> scratch_;
+    double errorVariance_;
+};
+
+#endif
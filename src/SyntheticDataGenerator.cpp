@@ -1,4 +1,6 @@
 #include "SyntheticDataGenerator.h"
+#include "CounterRng.h"
+#include "ThreadPool.h"
 #include <random>
 #include <cmath>
 
@@ -16,13 +18,70 @@ std::vector<double> SyntheticDataGenerator::generateGBM(
     std::mt19937 gen(seed == 0 ? std::random_device{}() : seed);
     std::normal_distribution<double> dist(0.0, 1.0);
 
+    // S_{t+1} = S_t * exp((mu - 0.5*sigma^2)*deltaT + sigma*sqrt(deltaT)*Z)
+    const double drift = (mu - 0.5 * sigma * sigma) * deltaT;
+    const double vol = sigma * std::sqrt(deltaT);
+
     double currentPrice = S0;
     for (int i = 0; i < n; ++i) {
         double Z = dist(gen);
-        // S_{t+1} = S_t * exp((mu - 0.5*sigma^2)*deltaT + sigma*sqrt(deltaT)*Z)
-        currentPrice *= std::exp((mu - 0.5 * sigma * sigma) * deltaT + sigma * std::sqrt(deltaT) * Z);
+        currentPrice *= std::exp(drift + vol * Z);
         prices.push_back(currentPrice);
     }
     return prices;
 }
 
+void SyntheticDataGenerator::generateGBMPath(
+    int pathIndex,
+    int n,
+    double S0,
+    double mu,
+    double sigma,
+    double deltaT,
+    unsigned int seed,
+    double* out
+) {
+    if (n <= 0) return;
+    const double drift = (mu - 0.5 * sigma * sigma) * deltaT;
+    const double vol = sigma * std::sqrt(deltaT);
+
+    // Normals straight into the output row, then log S_t as a running sum of
+    // increments, then one exp per element (no running product).
+    CounterRng rng(seed, static_cast<std::uint64_t>(pathIndex));
+    rng.normals(0, out, n);
+    double logPrice = std::log(S0);
+    for (int i = 0; i < n; ++i) {
+        logPrice += drift + vol * out[i];
+        out[i] = logPrice;
+    }
+    for (int i = 0; i < n; ++i) {
+        out[i] = std::exp(out[i]);
+    }
+}
+
+std::vector<double> SyntheticDataGenerator::generateGBMPaths(
+    int numPaths,
+    int n,
+    double S0,
+    double mu,
+    double sigma,
+    double deltaT,
+    unsigned int seed,
+    ThreadPool* pool
+) {
+    if (numPaths <= 0 || n <= 0) return std::vector<double>();
+    if (seed == 0) seed = std::random_device{}();
+
+    std::vector<double> paths(static_cast<std::size_t>(numPaths) * n);
+    auto body = [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t p = begin; p < end; ++p) {
+            generateGBMPath(static_cast<int>(p), n, S0, mu, sigma, deltaT, seed, paths.data() + p * n);
+        }
+    };
+    if (pool) {
+        pool->parallelFor(numPaths, 1, body);
+    } else {
+        body(0, numPaths, 0);
+    }
+    return paths;
+}
@@ -3,6 +3,8 @@
 
 #include <vector>
 
+class ThreadPool;
+
 class SyntheticDataGenerator {
 public:
     // Generate synthetic stock prices via Geometric Brownian Motion.
@@ -20,8 +22,35 @@ public:
         double deltaT,
         unsigned int seed = 0
     );
-};
 
-#endif
+    // Generate numPaths independent GBM paths of n points each into a
+    // contiguous row-major numPaths x n matrix (row p is path p).
+    // Each path draws from its own Philox stream keyed by (seed, path index),
+    // so any path is reproducible on its own and the result does not depend
+    // on 'pool' (optional; paths are spread across its workers).
+    static std::vector<double> generateGBMPaths(
+        int numPaths,
+        int n,
+        double S0,
+        double mu,
+        double sigma,
+        double deltaT,
+        unsigned int seed = 0,
+        ThreadPool* pool = nullptr
+    );
 
+    // Generate path 'pathIndex' of the generateGBMPaths() matrix into out[0..n).
+    // Does nothing when n <= 0.
+    static void generateGBMPath(
+        int pathIndex,
+        int n,
+        double S0,
+        double mu,
+        double sigma,
+        double deltaT,
+        unsigned int seed,
+        double* out
+    );
+};
 
+#endif
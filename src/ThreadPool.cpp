@@ -0,0 +1,166 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace {
+
+// Lets nested parallelFor() calls from a worker run on that worker's slot.
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+
+void pinThread(std::thread& t, int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(t.native_handle(), static_cast<DWORD_PTR>(1) << cpu);
+#else
+    (void)t;
+    (void)cpu;
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads, const std::vector<int>& affinity)
+    : pending_(0), stopping_(false)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const int workers = std::max(0, threads - 1);
+    for (int i = 0; i <= workers; ++i) {
+        queues_.emplace_back(new Queue());
+    }
+    for (int i = 0; i < workers; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        if (!affinity.empty()) {
+            pinThread(workers_.back(), affinity[i % affinity.size()]);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) {
+        t.join();
+    }
+}
+
+bool ThreadPool::popOwn(int self, Task& task) {
+    Queue& q = *queues_[self];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int self, Task& task) {
+    int n = static_cast<int>(queues_.size());
+    for (int k = 1; k < n; ++k) {
+        Queue& q = *queues_[(self + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = q.tasks.front();
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::finish(Job* job) {
+    if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        done_.notify_all();
+    }
+}
+
+bool ThreadPool::tryRun(int self) {
+    Task task;
+    if (!popOwn(self, task) && !steal(self, task)) {
+        return false;
+    }
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    (*task.job->body)(task.begin, task.end, self);
+    finish(task.job);
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    t_pool = this;
+    t_workerIndex = index;
+    for (;;) {
+        if (tryRun(index)) continue;
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+        if (stopping_) return;
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const RangeBody& body) {
+    if (count == 0) return;
+    if (t_pool != this) {
+        // An outside thread: take the caller slot for the whole call. The
+        // thread-locals route nested calls from the body back to that slot
+        // without locking again; the previous values are restored after, in
+        // case this thread is a worker of another pool.
+        std::lock_guard<std::mutex> lock(callerMutex_);
+        const ThreadPool* prevPool = t_pool;
+        int prevIndex = t_workerIndex;
+        t_pool = this;
+        t_workerIndex = static_cast<int>(workers_.size());
+        run(count, grain, body, t_workerIndex);
+        t_pool = prevPool;
+        t_workerIndex = prevIndex;
+        return;
+    }
+    run(count, grain, body, t_workerIndex);
+}
+
+void ThreadPool::run(std::size_t count, std::size_t grain, const RangeBody& body, int self) {
+    grain = std::max<std::size_t>(1, grain);
+    std::size_t chunks = (count + grain - 1) / grain;
+
+    if (workers_.empty() || chunks == 1) {
+        body(0, count, self);
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.remaining.store(chunks);
+    pending_.fetch_add(chunks);
+
+    int n = static_cast<int>(queues_.size());
+    for (std::size_t c = 0; c < chunks; ++c) {
+        Task task = { c * grain, std::min(count, (c + 1) * grain), &job };
+        Queue& q = *queues_[c % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(task);
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wake_.notify_all();
+
+    // Help until every chunk of this job has completed.
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (tryRun(self)) continue;
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        done_.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+    }
+}
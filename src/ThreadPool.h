@@ -0,0 +1,79 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size work-stealing thread pool.
+//
+// parallelFor() splits [0, count) into chunks of 'grain' items and deals them
+// round-robin onto per-worker deques. Each worker pops from the back of its
+// own deque and, when empty, steals from the front of the others. The calling
+// thread joins in until its job is finished, so nested parallelFor() calls
+// cannot deadlock. Calls from threads outside the pool are serialized: they
+// all run on the one caller slot, so a second caller waits for the first.
+class ThreadPool {
+public:
+    // body(begin, end, worker): process items [begin, end). 'worker' is in
+    // [0, concurrency()) and identifies the executing thread, so it can index
+    // per-worker scratch storage. Threads outside the pool use the last slot.
+    // A body that calls parallelFor() itself may run other chunks on its
+    // thread while it waits, so it must not hold slot scratch across the call.
+    typedef std::function<void(std::size_t, std::size_t, int)> RangeBody;
+
+    // threads: threads running the work, counting the caller, so threads - 1
+    // background workers are started (0 = hardware concurrency; 1 runs every
+    // body on the calling thread).
+    // affinity: optional CPU ids; worker i is pinned to affinity[i % size].
+    explicit ThreadPool(int threads = 0, const std::vector<int>& affinity = std::vector<int>());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Background workers plus the calling thread.
+    int concurrency() const { return static_cast<int>(workers_.size()) + 1; }
+
+    void parallelFor(std::size_t count, std::size_t grain, const RangeBody& body);
+
+private:
+    struct Job {
+        const RangeBody* body;
+        std::atomic<std::size_t> remaining;
+    };
+    struct Task {
+        std::size_t begin;
+        std::size_t end;
+        Job* job;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int index);
+    bool tryRun(int self);
+    bool popOwn(int self, Task& task);
+    bool steal(int self, Task& task);
+    void finish(Job* job);
+    void run(std::size_t count, std::size_t grain, const RangeBody& body, int self);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<Queue>> queues_; // one per worker, plus one for callers
+    std::mutex callerMutex_;                     // held by an outside caller for its whole call
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::atomic<std::size_t> pending_;
+    bool stopping_;
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "Trace.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+const int kMaxPhases = 64;
+const int kMaxCounters = 64;
+// Bucket k < kBuckets - 1 counts durations of at most 2^(k + 8) ns (and above
+// the previous bound), matching the Prometheus 'le' labels; the last one is
+// the +Inf overflow bucket.
+const int kBuckets = 29;
+const std::size_t kMaxEventsPerThread = std::size_t(1) << 20;
+
+struct PhaseStats {
+    std::string name;
+    std::atomic<std::uint64_t> count {0};
+    std::atomic<std::uint64_t> sumNs {0};
+    std::atomic<std::uint64_t> buckets[kBuckets] = {};
+};
+
+struct CounterStats {
+    std::string name;
+    std::atomic<std::uint64_t> value {0};
+};
+
+struct Event {
+    int phase;
+    std::uint64_t startNs;
+    std::uint64_t durationNs;
+};
+
+struct ThreadBuffer {
+    int tid;
+    std::vector<Event> events;
+};
+
+struct Registry {
+    std::mutex mutex;
+    PhaseStats phases[kMaxPhases];
+    std::atomic<int> phaseCount {0};
+    CounterStats counters[kMaxCounters];
+    std::atomic<int> counterCount {0};
+    std::vector<std::unique_ptr<ThreadBuffer> > threads;
+    std::atomic<bool> recording {false};
+    std::atomic<std::uint64_t> droppedEvents {0};
+    std::uint64_t epochNs = Trace::nowNs();
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.emplace_back(new ThreadBuffer());
+        t_buffer = r.threads.back().get();
+        t_buffer->tid = static_cast<int>(r.threads.size());
+    }
+    return *t_buffer;
+}
+
+int bucketFor(std::uint64_t ns) {
+    if (ns == 0) return 0;
+    // Smallest k with ns <= 2^(k + 8): the bit length of (ns - 1) >> 8.
+    int k = 0;
+    for (ns = (ns - 1) >> 8; ns != 0 && k < kBuckets - 1; ns >>= 1) ++k;
+    return k;
+}
+
+// Find 'name' among the first 'count' slots or claim the next one.
+template <class Stats>
+int registerName(Stats* slots, std::atomic<int>& count, int capacity, const char* name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    int n = count.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i) {
+        if (slots[i].name == name) return i;
+    }
+    if (n == capacity) {
+        std::cerr << "Trace: too many distinct names; ignoring '" << name << "'.\n";
+        return -1;
+    }
+    slots[n].name = name;
+    count.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+void writeJsonString(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+bool Trace::compiledIn() {
+#if defined(AR_ENABLE_TRACING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Trace::setRecording(bool enabled) {
+    registry().recording.store(enabled, std::memory_order_relaxed);
+}
+
+bool Trace::recording() {
+    return registry().recording.load(std::memory_order_relaxed);
+}
+
+int Trace::registerPhase(const char* name) {
+    Registry& r = registry();
+    return registerName(r.phases, r.phaseCount, kMaxPhases, name);
+}
+
+int Trace::registerCounter(const char* name) {
+    Registry& r = registry();
+    return registerName(r.counters, r.counterCount, kMaxCounters, name);
+}
+
+void Trace::record(int phase, std::uint64_t startNs, std::uint64_t durationNs) {
+    if (phase < 0) return;
+    Registry& r = registry();
+    PhaseStats& p = r.phases[phase];
+    p.count.fetch_add(1, std::memory_order_relaxed);
+    p.sumNs.fetch_add(durationNs, std::memory_order_relaxed);
+    p.buckets[bucketFor(durationNs)].fetch_add(1, std::memory_order_relaxed);
+
+    if (r.recording.load(std::memory_order_relaxed)) {
+        ThreadBuffer& buffer = threadBuffer();
+        if (buffer.events.size() < kMaxEventsPerThread) {
+            buffer.events.push_back(Event {phase, startNs, durationNs});
+        } else {
+            r.droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Trace::add(int counter, std::uint64_t delta) {
+    if (counter < 0) return;
+    registry().counters[counter].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+bool Trace::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error opening " << path << " for writing.\n";
+        return false;
+    }
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    char buf[64];
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& t : r.threads) {
+        for (const Event& e : t->events) {
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(out, r.phases[e.phase].name);
+            // Chrome trace timestamps are microseconds.
+            std::snprintf(buf, sizeof(buf), "%.3f", (e.startNs - r.epochNs) / 1e3);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << t->tid << ",\"ts\":" << buf;
+            std::snprintf(buf, sizeof(buf), "%.3f", e.durationNs / 1e3);
+            out << ",\"dur\":" << buf << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    std::uint64_t dropped = r.droppedEvents.load(std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::cerr << "Trace: " << dropped << " events dropped (per-thread buffer full).\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void Trace::writePrometheus(std::ostream& out) {
+    Registry& r = registry();
+    char buf[64];
+    int phases = r.phaseCount.load(std::memory_order_acquire);
+    out << "# HELP ar_phase_seconds Latency of instrumented phases.\n"
+        << "# TYPE ar_phase_seconds histogram\n";
+    for (int i = 0; i < phases; ++i) {
+        const PhaseStats& p = r.phases[i];
+        std::uint64_t cumulative = 0;
+        for (int k = 0; k < kBuckets; ++k) {
+            cumulative += p.buckets[k].load(std::memory_order_relaxed);
+            out << "ar_phase_seconds_bucket{phase=\"" << p.name << "\",le=\"";
+            if (k == kBuckets - 1) {
+                out << "+Inf";
+            } else {
+                std::snprintf(buf, sizeof(buf), "%g", static_cast<double>(std::uint64_t(1) << (k + 8)) * 1e-9);
+                out << buf;
+            }
+            out << "\"} " << cumulative << "\n";
+        }
+        std::snprintf(buf, sizeof(buf), "%.9g", p.sumNs.load(std::memory_order_relaxed) * 1e-9);
+        out << "ar_phase_seconds_sum{phase=\"" << p.name << "\"} " << buf << "\n"
+            << "ar_phase_seconds_count{phase=\"" << p.name << "\"} "
+            << p.count.load(std::memory_order_relaxed) << "\n";
+    }
+
+    int counters = r.counterCount.load(std::memory_order_acquire);
+    out << "# HELP ar_events_total Instrumented event counters.\n"
+        << "# TYPE ar_events_total counter\n";
+    for (int i = 0; i < counters; ++i) {
+        out << "ar_events_total{name=\"" << r.counters[i].name << "\"} "
+            << r.counters[i].value.load(std::memory_order_relaxed) << "\n";
+    }
+}
+
+bool Trace::writePrometheus(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error opening " << path << " for writing.\n";
+        return false;
+    }
+    writePrometheus(out);
+    return static_cast<bool>(out);
+}
+
+void Trace::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (PhaseStats& p : r.phases) {
+        p.count.store(0, std::memory_order_relaxed);
+        p.sumNs.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& b : p.buckets) b.store(0, std::memory_order_relaxed);
+    }
+    for (CounterStats& c : r.counters) c.value.store(0, std::memory_order_relaxed);
+    for (std::unique_ptr<ThreadBuffer>& t : r.threads) t->events.clear();
+    r.droppedEvents.store(0, std::memory_order_relaxed);
+}
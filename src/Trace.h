@@ -0,0 +1,82 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Low-overhead instrumentation of the hot paths.
+//
+// AR_TRACE_SCOPE("phase") times the enclosing scope into a per-phase latency
+// histogram (log2 buckets from 256 ns to ~34 s); AR_TRACE_COUNT("name", n)
+// bumps a counter. Both are lock-free after the first call at each site.
+// While event recording is on, every scope is also kept as a Chrome-trace
+// "complete" event in a per-thread buffer.
+//
+// Without AR_ENABLE_TRACING (CMake option of the same name) the macros
+// expand to nothing; the Trace class still links, with nothing recorded.
+//
+// Exports are meant to run once the traced work has finished: they read the
+// per-thread event buffers without synchronizing with their writers.
+class Trace {
+public:
+    // True if this build was compiled with AR_ENABLE_TRACING.
+    static bool compiledIn();
+
+    // Keep individual scope events for writeChromeTrace() (off by default;
+    // histograms and counters are always collected).
+    static void setRecording(bool enabled);
+    static bool recording();
+
+    // Chrome trace / Perfetto JSON ("traceEvents" array of "X" events).
+    static bool writeChromeTrace(const std::string& path);
+    // Prometheus text exposition: ar_phase_seconds histograms and
+    // ar_events_total counters.
+    static void writePrometheus(std::ostream& out);
+    static bool writePrometheus(const std::string& path);
+
+    // Clear histograms, counters and recorded events.
+    static void reset();
+
+    // Used by the macros below.
+    static int registerPhase(const char* name);
+    static int registerCounter(const char* name);
+    static void record(int phase, std::uint64_t startNs, std::uint64_t durationNs);
+    static void add(int counter, std::uint64_t delta);
+    static std::uint64_t nowNs() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    class Scope {
+    public:
+        explicit Scope(int phase) : phase_(phase), start_(nowNs()) {}
+        ~Scope() { record(phase_, start_, nowNs() - start_); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int phase_;
+        std::uint64_t start_;
+    };
+};
+
+#define AR_TRACE_CONCAT_(a, b) a##b
+#define AR_TRACE_CONCAT(a, b) AR_TRACE_CONCAT_(a, b)
+
+#if defined(AR_ENABLE_TRACING)
+#define AR_TRACE_SCOPE(name)                                                                   \
+    static const int AR_TRACE_CONCAT(arTracePhase_, __LINE__) = ::Trace::registerPhase(name); \
+    ::Trace::Scope AR_TRACE_CONCAT(arTraceScope_, __LINE__)(AR_TRACE_CONCAT(arTracePhase_, __LINE__))
+#define AR_TRACE_COUNT(name, delta)                                      \
+    do {                                                                 \
+        static const int arTraceCounter_ = ::Trace::registerCounter(name); \
+        ::Trace::add(arTraceCounter_, static_cast<std::uint64_t>(delta)); \
+    } while (0)
+#else
+#define AR_TRACE_SCOPE(name) do {} while (0)
+#define AR_TRACE_COUNT(name, delta) do {} while (0)
+#endif
+
+#endif
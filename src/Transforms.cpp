@@ -0,0 +1,193 @@
+#include "Transforms.h"
+#include "PanelIO.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+std::size_t Transforms::difference(const double* x, std::size_t n, double* out, std::size_t lag) {
+    if (lag == 0 || n <= lag) return 0;
+    SimdKernels::difference(x, n, lag, out);
+    return n - lag;
+}
+
+std::vector<double> Transforms::difference(SeriesView x, std::size_t lag) {
+    std::vector<double> out(x.size() > lag ? x.size() - lag : 0);
+    difference(x.data(), x.size(), out.data(), lag);
+    return out;
+}
+
+std::size_t Transforms::logReturns(const double* x, std::size_t n, double* out, std::size_t lag) {
+    if (lag == 0 || n <= lag) return 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = std::log(x[i]);
+    }
+    SimdKernels::difference(out, n, lag, out);
+    return n - lag;
+}
+
+std::vector<double> Transforms::logReturns(SeriesView x, std::size_t lag) {
+    std::vector<double> out(x.size());
+    out.resize(logReturns(x.data(), x.size(), out.data(), lag));
+    return out;
+}
+
+void Transforms::integrate(const double* d, std::size_t n, const double* seed, double* out,
+                           std::size_t lag) {
+    if (lag == 0) return;
+    std::size_t head = std::min(lag, n);
+    for (std::size_t i = 0; i < head; ++i) {
+        out[i] = seed[i] + d[i];
+    }
+    // Lag 1 is one dependency chain; larger lags are lag interleaved chains.
+    for (std::size_t i = head; i < n; ++i) {
+        out[i] = out[i - lag] + d[i];
+    }
+}
+
+void Transforms::integrateLog(const double* d, std::size_t n, const double* seed, double* out,
+                              std::size_t lag) {
+    if (lag == 0) return;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = std::exp(d[i]);
+    }
+    std::size_t head = std::min(lag, n);
+    for (std::size_t i = 0; i < head; ++i) {
+        out[i] *= seed[i];
+    }
+    for (std::size_t i = head; i < n; ++i) {
+        out[i] *= out[i - lag];
+    }
+}
+
+namespace {
+
+void forColumns(std::size_t columns, ThreadPool* pool, const ThreadPool::RangeBody& fn) {
+    if (pool) {
+        pool->parallelFor(columns, 1, fn);
+    } else {
+        fn(0, columns, 0);
+    }
+}
+
+} // namespace
+
+void Transforms::apply(SeriesTransform transform, const Panel& in, Panel& out, std::size_t lag,
+                       ThreadPool* pool) {
+    const std::size_t rows = in.rows;
+    out.names = in.names;
+    out.rows = transform == SeriesTransform::None ? rows : (rows > lag && lag > 0 ? rows - lag : 0);
+    out.values.resize(in.columns() * out.rows);
+    if (out.rows == 0) return;
+
+    const double* src = in.values.data();
+    double* dst = out.values.data();
+    const std::size_t outRows = out.rows;
+    std::vector<std::vector<double> > scratch(transform == SeriesTransform::LogReturn && pool
+                                              ? pool->concurrency() : 1);
+    forColumns(in.columns(), pool, [&](std::size_t begin, std::size_t end, int worker) {
+        for (std::size_t c = begin; c < end; ++c) {
+            const double* x = src + c * rows;
+            double* y = dst + c * outRows;
+            switch (transform) {
+            case SeriesTransform::None:
+                std::copy(x, x + rows, y);
+                break;
+            case SeriesTransform::Difference:
+                SimdKernels::difference(x, rows, lag, y);
+                break;
+            case SeriesTransform::LogReturn: {
+                // The column's logs need all rows, one more lag than y holds.
+                std::vector<double>& logs = scratch[worker];
+                logs.resize(rows);
+                logReturns(x, rows, logs.data(), lag);
+                std::copy(logs.begin(), logs.begin() + outRows, y);
+                break;
+            }
+            }
+        }
+    });
+}
+
+void Transforms::apply(SeriesTransform transform, Panel& panel, std::size_t lag, ThreadPool* pool) {
+    if (transform == SeriesTransform::None) return;
+    const std::size_t rows = panel.rows;
+    const std::size_t outRows = rows > lag && lag > 0 ? rows - lag : 0;
+    double* data = panel.values.data();
+    if (outRows > 0) {
+        forColumns(panel.columns(), pool, [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t c = begin; c < end; ++c) {
+                double* x = data + c * rows;
+                if (transform == SeriesTransform::Difference) {
+                    SimdKernels::difference(x, rows, lag, x);
+                } else {
+                    logReturns(x, rows, x, lag);
+                }
+            }
+        });
+        // Column c moves down to c * outRows; every destination lies below
+        // its source, so a forward copy in column order is safe.
+        for (std::size_t c = 1; c < panel.columns(); ++c) {
+            std::copy(data + c * rows, data + c * rows + outRows, data + c * outRows);
+        }
+    }
+    panel.rows = outRows;
+    panel.values.resize(panel.columns() * outRows);
+}
+
+void Transforms::integrate(const Panel& d, const double* seeds, Panel& out, std::size_t lag,
+                           ThreadPool* pool) {
+    const std::size_t rows = d.rows;
+    if (&out != &d) {
+        out.rows = rows;
+        out.names = d.names;
+        out.values.resize(d.values.size());
+    }
+    if (lag == 0 || rows == 0) return;
+
+    const double* src = d.values.data();
+    double* dst = out.values.data();
+    const std::size_t kInterleave = 8;
+    const std::size_t columns = d.columns();
+    const std::size_t blocks = (columns + kInterleave - 1) / kInterleave;
+    forColumns(blocks, pool, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t b = begin; b < end; ++b) {
+            std::size_t c0 = b * kInterleave;
+            std::size_t width = std::min(kInterleave, columns - c0);
+            if (lag > 1) {
+                for (std::size_t c = c0; c < c0 + width; ++c) {
+                    integrate(src + c * rows, rows, seeds + c * lag, dst + c * rows, lag);
+                }
+                continue;
+            }
+            // Row by row across the block: each column's additions keep
+            // their order, but eight independent chains are in flight.
+            double level[kInterleave];
+            for (std::size_t j = 0; j < width; ++j) level[j] = seeds[c0 + j];
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t j = 0; j < width; ++j) {
+                    level[j] += src[(c0 + j) * rows + i];
+                    dst[(c0 + j) * rows + i] = level[j];
+                }
+            }
+        }
+    });
+}
+
+void Transforms::integrateLog(const Panel& d, const double* seeds, Panel& out, std::size_t lag,
+                              ThreadPool* pool) {
+    const std::size_t rows = d.rows;
+    if (&out != &d) {
+        out.rows = rows;
+        out.names = d.names;
+        out.values.resize(d.values.size());
+    }
+    if (lag == 0 || rows == 0) return;
+
+    const double* src = d.values.data();
+    double* dst = out.values.data();
+    forColumns(d.columns(), pool, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t c = begin; c < end; ++c) {
+            integrateLog(src + c * rows, rows, seeds + c * lag, dst + c * rows, lag);
+        }
+    });
+}
@@ -0,0 +1,66 @@
+#ifndef TRANSFORMS_H
+#define TRANSFORMS_H
+
+#include <cstddef>
+#include <vector>
+#include "SeriesView.h"
+#include "ThreadPool.h"
+
+struct Panel;
+
+// What is fitted in place of the raw level series.
+enum class SeriesTransform { None, Difference, LogReturn };
+
+// Stationarizing transforms and their inverses. Lag 1 gives first
+// differences; lag s > 1 gives seasonal differences x[t] - x[t-s].
+//
+// Differencing runs through SimdKernels::difference() and is exact, so it is
+// identical on every ISA. Integration is a prefix scan and stays sequential
+// within each series, so an integrated forecast is bitwise the running sum
+// 'level += d[i]'; the panel overloads get their parallelism from columns.
+// The log and exp in logReturns()/integrateLog() are scalar std::log and
+// std::exp calls.
+class Transforms {
+public:
+    // out[i] = x[i + lag] - x[i] for i < n - lag; returns n - lag (0 if
+    // n <= lag). out may equal x.
+    static std::size_t difference(const double* x, std::size_t n, double* out, std::size_t lag = 1);
+    static std::vector<double> difference(SeriesView x, std::size_t lag = 1);
+
+    // out[i] = log(x[i + lag]) - log(x[i]); returns n - lag. out must hold n
+    // values (the logs are taken in place first) and may equal x.
+    static std::size_t logReturns(const double* x, std::size_t n, double* out, std::size_t lag = 1);
+    static std::vector<double> logReturns(SeriesView x, std::size_t lag = 1);
+
+    // Inverse of difference(): out[i] = out[i - lag] + d[i], where the lag
+    // levels preceding d are seed[0..lag). out may equal d.
+    static void integrate(const double* d, std::size_t n, const double* seed, double* out,
+                          std::size_t lag = 1);
+
+    // Inverse of logReturns(): out[i] = out[i - lag] * exp(d[i]).
+    static void integrateLog(const double* d, std::size_t n, const double* seed, double* out,
+                             std::size_t lag = 1);
+
+    // Whole panels, one column per series, columns spread over 'pool'
+    // (optional). 'out' gets rows - lag rows (SeriesTransform::None copies)
+    // and the same column names; it must not be 'in'.
+    static void apply(SeriesTransform transform, const Panel& in, Panel& out, std::size_t lag = 1,
+                      ThreadPool* pool = nullptr);
+    // In place: each column is transformed where it lies, then the columns
+    // are packed down to rows - lag rows. No second panel is allocated.
+    static void apply(SeriesTransform transform, Panel& panel, std::size_t lag = 1,
+                      ThreadPool* pool = nullptr);
+
+    // Integrates every column of 'd' from its seeds (column c's lag levels
+    // at seeds[c * lag]); out may be d. Lag-1 scans are interleaved across
+    // neighbouring columns to overlap their dependency chains.
+    static void integrate(const Panel& d, const double* seeds, Panel& out, std::size_t lag = 1,
+                          ThreadPool* pool = nullptr);
+
+    // Inverse of the LogReturn transform for every column of 'd', seeded as
+    // above; out may be d. One integrateLog() scan per column.
+    static void integrateLog(const Panel& d, const double* seeds, Panel& out, std::size_t lag = 1,
+                             ThreadPool* pool = nullptr);
+};
+
+#endif
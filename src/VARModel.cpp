@@ -0,0 +1,319 @@
+#include "VARModel.h"
+#include "PanelIO.h"
+#include "SimdKernels.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+VARForecaster::VARForecaster()
+    : coefficients_(nullptr), dims_(0), order_(0), head_(0)
+{
+}
+
+void VARForecaster::reset(const double* reversedCoefficients, int dims, int order, const double* history) {
+    coefficients_ = reversedCoefficients;
+    dims_ = dims;
+    order_ = order;
+    head_ = 0;
+    const std::size_t w = static_cast<std::size_t>(order) * dims;
+    buffer_.assign(2 * w, 0.0);
+    std::copy(history, history + w, buffer_.begin());
+    std::copy(history, history + w, buffer_.begin() + w);
+}
+
+void VARForecaster::predict(double* out) const {
+    const std::size_t w = static_cast<std::size_t>(order_) * dims_;
+    const double* window = buffer_.data() + static_cast<std::size_t>(head_) * dims_;
+    for (int i = 0; i < dims_; ++i) {
+        out[i] = SimdKernels::dot(coefficients_ + i * w, window, w);
+    }
+}
+
+void VARForecaster::push(const double* value) {
+    if (order_ == 0) return;
+    // Overwrite the oldest vector in both halves; the window then starts one later.
+    std::copy(value, value + dims_, buffer_.begin() + static_cast<std::size_t>(head_) * dims_);
+    std::copy(value, value + dims_, buffer_.begin() + static_cast<std::size_t>(head_ + order_) * dims_);
+    if (++head_ == order_) head_ = 0;
+}
+
+void VARForecaster::forecast(int k, double* out) {
+    AR_TRACE_SCOPE("var_forecast");
+    for (int i = 0; i < k; ++i) {
+        step(out + static_cast<std::size_t>(i) * dims_);
+    }
+}
+
+namespace {
+
+// c -= a * b
+void matMulSub(const double* a, const double* b, double* c, int k) {
+    for (int i = 0; i < k; ++i) {
+        double* ci = c + i * k;
+        for (int l = 0; l < k; ++l) {
+            const double ail = a[i * k + l];
+            const double* bl = b + l * k;
+            for (int j = 0; j < k; ++j) {
+                ci[j] -= ail * bl[j];
+            }
+        }
+    }
+}
+
+void transpose(const double* a, double* out, int k) {
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k; ++j) {
+            out[j * k + i] = a[i * k + j];
+        }
+    }
+}
+
+void symmetrize(double* a, int k) {
+    for (int i = 0; i < k; ++i) {
+        for (int j = i + 1; j < k; ++j) {
+            double m = 0.5 * (a[i * k + j] + a[j * k + i]);
+            a[i * k + j] = m;
+            a[j * k + i] = m;
+        }
+    }
+}
+
+// x = d * s^-1 for symmetric positive definite s: each row of x solves
+// s x_r = d_r through the Cholesky factor (l, lower, row-major).
+bool solveRight(const double* s, const double* d, double* x, int k, std::vector<double>& l) {
+    l.assign(static_cast<std::size_t>(k) * k, 0.0);
+    for (int j = 0; j < k; ++j) {
+        double diag = s[j * k + j];
+        for (int m = 0; m < j; ++m) diag -= l[j * k + m] * l[j * k + m];
+        if (!(diag > 0.0)) return false;
+        diag = std::sqrt(diag);
+        l[j * k + j] = diag;
+        for (int i = j + 1; i < k; ++i) {
+            double v = s[i * k + j];
+            for (int m = 0; m < j; ++m) v -= l[i * k + m] * l[j * k + m];
+            l[i * k + j] = v / diag;
+        }
+    }
+    for (int r = 0; r < k; ++r) {
+        double* xr = x + r * k;
+        const double* dr = d + r * k;
+        for (int i = 0; i < k; ++i) {
+            double v = dr[i];
+            for (int m = 0; m < i; ++m) v -= l[i * k + m] * xr[m];
+            xr[i] = v / l[i * k + i];
+        }
+        for (int i = k - 1; i >= 0; --i) {
+            double v = xr[i];
+            for (int m = i + 1; m < k; ++m) v -= l[m * k + i] * xr[m];
+            xr[i] = v / l[i * k + i];
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+VARModel::VARModel(const double* columns, std::size_t rows, int dims, int order)
+    : columns_(columns), rows_(rows), dims_(dims), order_(order)
+{
+}
+
+VARModel::VARModel(const Panel& panel, int order)
+    : VARModel(panel.values.data(), panel.rows, static_cast<int>(panel.columns()), order)
+{
+}
+
+void VARModel::autocovariances(const double* columns, std::size_t rows, int dims, int maxLag,
+                               std::vector<double>& out) {
+    AR_TRACE_SCOPE("var_autocovariance");
+    const std::size_t k = dims, kk = k * k;
+    out.assign((maxLag + 1) * kk, 0.0);
+    if (rows == 0 || dims <= 0) return;
+
+    // Time tiles of 2048 / k rows (16 KB across all series, inside L1) for up
+    // to eight series; wider panels keep a 256-row floor, 2 KB per series,
+    // so their tiles outgrow L1 and are reused from L2. Every lagged product
+    // of the tile is formed while it is cached, four columns of Gamma(h) at
+    // a time against each row series.
+    const std::size_t tile = std::max<std::size_t>(256, (std::size_t(1) << 11) / k);
+    const double* b[4];
+    double partial[4];
+    for (std::size_t t0 = 0; t0 < rows; t0 += tile) {
+        const std::size_t t1 = std::min(rows, t0 + tile);
+        for (int h = 0; h <= maxLag; ++h) {
+            const std::size_t start = std::max<std::size_t>(t0, h);
+            if (start >= t1) continue;
+            const std::size_t len = t1 - start;
+            double* g = out.data() + h * kk;
+            for (std::size_t i = 0; i < k; ++i) {
+                const double* xi = columns + i * rows + start;
+                // Gamma(0) is symmetric: the lower triangle is mirrored below.
+                std::size_t j = h == 0 ? i : 0;
+                for (; j + 4 <= k; j += 4) {
+                    for (int q = 0; q < 4; ++q) b[q] = columns + (j + q) * rows + start - h;
+                    SimdKernels::dot4(xi, b, len, partial);
+                    for (int q = 0; q < 4; ++q) g[i * k + j + q] += partial[q];
+                }
+                for (; j < k; ++j) {
+                    g[i * k + j] += SimdKernels::dot(xi, columns + j * rows + start - h, len);
+                }
+            }
+        }
+    }
+    const double scale = 1.0 / static_cast<double>(rows);
+    for (double& v : out) v *= scale;
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = 0; j < i; ++j) out[i * k + j] = out[j * k + i];
+    }
+}
+
+bool VARModel::whittle(const std::vector<double>& gamma, int dims, int order,
+                       std::vector<double>& coefficients, std::vector<double>& errorCovariance) {
+    AR_TRACE_SCOPE("var_whittle");
+    const int k = dims;
+    const std::size_t kk = static_cast<std::size_t>(k) * k;
+    if (k <= 0 || order < 0 || gamma.size() < (order + 1) * kk) return false;
+
+    // Forward (A) and backward (B) coefficients of the current order m, and
+    // their prediction-error covariances V and U.
+    std::vector<double> a(order * kk, 0.0), b(order * kk, 0.0), aPrev, bPrev;
+    std::vector<double> v(gamma.begin(), gamma.begin() + kk), u = v;
+    std::vector<double> delta(kk), deltaT(kk), scratch;
+    for (int m = 0; m < order; ++m) {
+        // Delta = Gamma(m+1) - sum_{j=1}^{m} A_j Gamma(m+1-j)
+        std::copy(gamma.begin() + (m + 1) * kk, gamma.begin() + (m + 2) * kk, delta.begin());
+        for (int j = 1; j <= m; ++j) {
+            matMulSub(a.data() + (j - 1) * kk, gamma.data() + (m + 1 - j) * kk, delta.data(), k);
+        }
+        transpose(delta.data(), deltaT.data(), k);
+
+        // Reflection coefficients: A_{m+1} = Delta U^-1, B_{m+1} = Delta^T V^-1.
+        double* aNew = a.data() + m * kk;
+        double* bNew = b.data() + m * kk;
+        if (!solveRight(u.data(), delta.data(), aNew, k, scratch) ||
+            !solveRight(v.data(), deltaT.data(), bNew, k, scratch)) {
+            std::cerr << "Prediction-error covariance not positive definite at VAR order " << m + 1 << ".\n";
+            return false;
+        }
+
+        // A_j -= A_{m+1} B_{m+1-j}, B_j -= B_{m+1} A_{m+1-j}, j = 1..m.
+        aPrev.assign(a.begin(), a.begin() + m * kk);
+        bPrev.assign(b.begin(), b.begin() + m * kk);
+        for (int j = 1; j <= m; ++j) {
+            matMulSub(aNew, bPrev.data() + (m - j) * kk, a.data() + (j - 1) * kk, k);
+            matMulSub(bNew, aPrev.data() + (m - j) * kk, b.data() + (j - 1) * kk, k);
+        }
+
+        // V -= A_{m+1} Delta^T, U -= B_{m+1} Delta.
+        matMulSub(aNew, deltaT.data(), v.data(), k);
+        matMulSub(bNew, delta.data(), u.data(), k);
+        symmetrize(v.data(), k);
+        symmetrize(u.data(), k);
+    }
+    coefficients.swap(a);
+    errorCovariance.swap(v);
+    return true;
+}
+
+bool VARModel::computeCoefficients() {
+    if (dims_ <= 0 || order_ < 0 || rows_ <= static_cast<std::size_t>(order_)) {
+        std::cerr << "Not enough data to compute VAR coefficients.\n";
+        return false;
+    }
+    std::vector<double> gamma;
+    autocovariances(columns_, rows_, dims_, order_, gamma);
+    if (!whittle(gamma, dims_, order_, coefficients_, errorCovariance_)) return false;
+
+    // Row i of [A_p | ... | A_1] against an oldest-first window.
+    const std::size_t k = dims_, w = order_ * k;
+    reversedCoefficients_.assign(k * w, 0.0);
+    for (int lag = 1; lag <= order_; ++lag) {
+        const double* A = coefficientsFor(lag);
+        const std::size_t offset = (order_ - lag) * k;
+        for (std::size_t i = 0; i < k; ++i) {
+            std::copy(A + i * k, A + (i + 1) * k, reversedCoefficients_.begin() + i * w + offset);
+        }
+    }
+    return true;
+}
+
+bool VARModel::initForecaster(VARForecaster& forecaster) const {
+    if (rows_ < static_cast<std::size_t>(order_) ||
+        reversedCoefficients_.size() != static_cast<std::size_t>(order_) * dims_ * dims_) {
+        std::cerr << "Insufficient data for multi-step prediction.\n";
+        return false;
+    }
+    // Last 'order' observations, gathered time-major.
+    std::vector<double> history(static_cast<std::size_t>(order_) * dims_);
+    for (int t = 0; t < order_; ++t) {
+        for (int c = 0; c < dims_; ++c) {
+            history[t * dims_ + c] = columns_[c * rows_ + rows_ - order_ + t];
+        }
+    }
+    forecaster.reset(reversedCoefficients_.data(), dims_, order_, history.data());
+    return true;
+}
+
+bool VARModel::forwardPredict(double* out) const {
+    return forwardPredictSteps(1, out);
+}
+
+std::vector<double> VARModel::forwardPredict() const {
+    std::vector<double> out(dims_);
+    if (!forwardPredict(out.data())) out.clear();
+    return out;
+}
+
+bool VARModel::forwardPredictSteps(int k, double* out) const {
+    VARForecaster forecaster;
+    if (!initForecaster(forecaster)) return false;
+    forecaster.forecast(k, out);
+    return true;
+}
+
+std::vector<double> VARModel::forwardPredictSteps(int k) const {
+    std::vector<double> out(static_cast<std::size_t>(k) * dims_);
+    if (!forwardPredictSteps(k, out.data())) out.clear();
+    return out;
+}
+
+VARComponent VARModel::component(int component) const {
+    return VARComponent(*this, component);
+}
+
+VARComponent::VARComponent(const VARModel& model, int component)
+    : model_(&model), component_(component)
+{
+}
+
+double VARComponent::forwardPredict() const {
+    double out = 0.0;
+    if (!forwardPredictSteps(1, &out)) return 0.0;
+    return out;
+}
+
+bool VARComponent::forwardPredictSteps(int k, double* out) const {
+    const int dims = model_->dims();
+    if (component_ < 0 || component_ >= dims) {
+        std::cerr << "VAR component " << component_ << " out of range.\n";
+        return false;
+    }
+    std::vector<double> all(static_cast<std::size_t>(k) * dims);
+    if (!model_->forwardPredictSteps(k, all.data())) return false;
+    for (int s = 0; s < k; ++s) out[s] = all[static_cast<std::size_t>(s) * dims + component_];
+    return true;
+}
+
+std::vector<double> VARComponent::forwardPredictSteps(int k) const {
+    std::vector<double> out(k);
+    if (!forwardPredictSteps(k, out.data())) out.clear();
+    return out;
+}
+
+double VARComponent::getErrorVariance() const {
+    const int dims = model_->dims();
+    const std::vector<double>& sigma = model_->getErrorCovariance();
+    if (component_ < 0 || component_ >= dims || sigma.size() != static_cast<std::size_t>(dims) * dims) return 0.0;
+    return sigma[static_cast<std::size_t>(component_) * dims + component_];
+}
@@ -0,0 +1,148 @@
+#ifndef VAR_MODEL_H
+#define VAR_MODEL_H
+
+#include <cstddef>
+#include <vector>
+
+struct Panel;
+
+// Multivariate counterpart of RingForecaster: the last 'order' observation
+// vectors (time-major, 'dims' values each) are stored twice, so the
+// oldest-first window of order * dims values is always contiguous and each
+// component of a step is one contiguous dot product with a row of the
+// reversed coefficient matrix [A_p | ... | A_1].
+class VARForecaster {
+public:
+    VARForecaster();
+
+    // reversedCoefficients: dims x (order * dims), row-major (must outlive
+    // the forecaster). history: the last 'order' observations, oldest first.
+    void reset(const double* reversedCoefficients, int dims, int order, const double* history);
+
+    // Prediction of the next observation into out[0..dims), without
+    // advancing.
+    void predict(double* out) const;
+
+    // Append an observation vector, dropping the oldest.
+    void push(const double* value);
+
+    void step(double* out) {
+        predict(out);
+        push(out);
+    }
+
+    // Write k recursive forecasts into out[0..k * dims), step-major.
+    void forecast(int k, double* out);
+
+    const double* window() const { return buffer_.data() + static_cast<std::size_t>(head_) * dims_; }
+    int order() const { return order_; }
+    int dims() const { return dims_; }
+
+private:
+    const double* coefficients_;
+    std::vector<double> buffer_; // 2 * order_ * dims_
+    int dims_;
+    int order_;
+    int head_;
+};
+
+// Vector autoregression VAR(p) over 'dims' aligned series:
+//   x[t] = A_1 x[t-1] + ... + A_p x[t-p] + e[t],  e[t] ~ (0, Sigma),
+// fitted by Yule-Walker like ARModel: lag autocovariances
+// Gamma(h) = (1/n) sum_t x[t] x[t-h]^T (series used as given, no mean
+// removal), then the block Toeplitz system is solved with the
+// Whittle (multivariate Levinson-Durbin) recursion, O(p^2 dims^3) instead
+// of a dense O((p dims)^3) solve.
+//
+// The autocovariances are accumulated over tiles of time steps that hold
+// every series at once, so each tile is loaded from memory once and all
+// dims^2 (p + 1) lagged products are formed from cache, register-blocked
+// four at a time (SimdKernels::dot4).
+//
+// Method names follow ARModel's (computeCoefficients, forwardPredict,
+// forwardPredictSteps), but here an observation is 'dims' values and
+// multi-step forecasts are step-major. component(c) gives the ARModel-shaped
+// view of one series (VARComponent below).
+class VARComponent;
+
+class VARModel {
+public:
+    // Zero-copy: 'columns' holds 'dims' series of 'rows' samples each,
+    // column-major (series c at columns[c * rows]), and must outlive the
+    // model.
+    VARModel(const double* columns, std::size_t rows, int dims, int order);
+    // Every column of 'panel' (which must outlive the model).
+    VARModel(const Panel& panel, int order);
+
+    bool computeCoefficients();
+
+    // One-step forecast of the next observation: 'dims' values.
+    std::vector<double> forwardPredict() const;
+    bool forwardPredict(double* out) const;
+
+    // k-step recursive forecast, k * dims values, step-major.
+    std::vector<double> forwardPredictSteps(int k) const;
+    bool forwardPredictSteps(int k, double* out) const;
+
+    // Arm 'forecaster' with the fitted coefficients and the last 'order'
+    // observations; the model must outlive it.
+    bool initForecaster(VARForecaster& forecaster) const;
+
+    // Lag autocovariances Gamma(0..maxLag), each dims x dims row-major,
+    // stacked: out[h * dims * dims + i * dims + j] = (1/n) sum_t x_i[t] x_j[t-h].
+    static void autocovariances(const double* columns, std::size_t rows, int dims, int maxLag,
+                                std::vector<double>& out);
+
+    // Whittle recursion on Gamma(0..order). Writes A_1..A_order (stacked
+    // dims x dims blocks) and the innovation covariance V_order. Returns
+    // false if a prediction-error covariance stops being positive definite.
+    static bool whittle(const std::vector<double>& gamma, int dims, int order,
+                        std::vector<double>& coefficients, std::vector<double>& errorCovariance);
+
+    // A_lag (1 <= lag <= order), dims x dims row-major.
+    const double* coefficientsFor(int lag) const {
+        return coefficients_.data() + static_cast<std::size_t>(lag - 1) * dims_ * dims_;
+    }
+    const std::vector<double>& getCoefficients() const { return coefficients_; }
+    // Innovation covariance Sigma (dims x dims) of the fitted model.
+    const std::vector<double>& getErrorCovariance() const { return errorCovariance_; }
+    int getOrder() const { return order_; }
+    int dims() const { return dims_; }
+
+    // Forecasts of series 'component' alone (0 <= component < dims).
+    VARComponent component(int component) const;
+
+private:
+    const double* columns_;
+    std::size_t rows_;
+    int dims_;
+    int order_;
+    std::vector<double> coefficients_;         // A_1..A_p
+    std::vector<double> reversedCoefficients_; // dims x (p * dims): [A_p | ... | A_1]
+    std::vector<double> errorCovariance_;
+};
+
+// One series of a fitted VARModel behind ARModel's forecasting calls, so code
+// templated on the model type (forwardPredict, forwardPredictSteps,
+// getOrder, getErrorVariance) takes a VAR component as it takes an ARModel.
+// Every call still runs the whole VAR recursion, as each series' future
+// depends on all of them. The model must outlive the view.
+class VARComponent {
+public:
+    VARComponent(const VARModel& model, int component);
+
+    double forwardPredict() const;
+    std::vector<double> forwardPredictSteps(int k) const;
+    bool forwardPredictSteps(int k, double* out) const;
+
+    int getOrder() const { return model_->getOrder(); }
+    // Innovation variance of this series: Sigma[c][c].
+    double getErrorVariance() const;
+    int component() const { return component_; }
+
+private:
+    const VARModel* model_;
+    int component_;
+};
+
+#endif
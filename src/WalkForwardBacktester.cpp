@@ -0,0 +1,200 @@
+#include "WalkForwardBacktester.h"
+#include "ARModel.h"
+#include "ARWorkspace.h"
+#include "SimdKernels.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+// Error sums of one block of origins, per forecast step.
+struct BlockTotals {
+    std::vector<double> sumSq;
+    std::vector<double> sumAbsPct;
+    std::size_t fitted = 0;
+    std::size_t failed = 0;
+};
+
+// Per-worker buffers, reused across every origin the worker handles.
+struct WorkerScratch {
+    ARWorkspace ws;
+    std::vector<double> lagSums;
+    std::vector<double> coefficients;
+    std::vector<double> reversed;
+    std::vector<double> forecast;
+};
+
+ErrorMetrics metricsFrom(double sumSq, double sumAbsPct, std::size_t n) {
+    ErrorMetrics em {0.0, 0.0, 0.0};
+    if (n == 0) return em;
+    em.mse = sumSq / n;
+    em.rmse = std::sqrt(em.mse);
+    em.mape = sumAbsPct / n;
+    return em;
+}
+
+} // namespace
+
+WalkForwardBacktester::WalkForwardBacktester(int threads)
+    : pool_(threads)
+{
+}
+
+WalkForwardResult WalkForwardBacktester::run(SeriesView series, const WalkForwardOptions& options) {
+    return runImpl(series, nullptr, options);
+}
+
+WalkForwardResult WalkForwardBacktester::run(SeriesView series, SeriesView levels,
+                                             const WalkForwardOptions& options) {
+    if (levels.size() != series.size() + 1) {
+        std::cerr << "Walk-forward levels must have one more sample than the series.\n";
+        return WalkForwardResult();
+    }
+    return runImpl(series, levels.data(), options);
+}
+
+WalkForwardResult WalkForwardBacktester::runImpl(SeriesView series, const double* levels,
+                                                 const WalkForwardOptions& options) {
+    AR_TRACE_SCOPE("walk_forward");
+    WalkForwardResult result;
+    const std::size_t n = series.size();
+    const std::size_t p = options.order > 0 ? static_cast<std::size_t>(options.order) : 0;
+    const std::size_t W = options.window;
+    const std::size_t s = options.step;
+    const std::size_t h = options.horizon > 0 ? static_cast<std::size_t>(options.horizon) : 0;
+    if (p == 0 || h == 0 || s == 0 || W <= p) {
+        std::cerr << "Walk-forward needs order >= 1, horizon >= 1, step >= 1 and window > order.\n";
+        return result;
+    }
+    if (n < W + h) {
+        std::cerr << "Not enough data for a walk-forward backtest.\n";
+        return result;
+    }
+
+    const double* x = series.data();
+    const std::size_t origins = (n - h - W) / s + 1;
+    const std::size_t blockSize = std::max<std::size_t>(1, options.blockOrigins);
+    const std::size_t blocks = (origins + blockSize - 1) / blockSize;
+    // Past this step size a fresh lag-product pass is cheaper than sliding.
+    const bool slide = 2 * s < W;
+
+    result.origins = origins;
+    if (options.keepForecasts) {
+        result.forecasts.assign(origins * h, std::numeric_limits<double>::quiet_NaN());
+    }
+
+    std::vector<BlockTotals> totals(blocks);
+    std::vector<WorkerScratch> scratch(pool_.concurrency());
+    for (WorkerScratch& w : scratch) {
+        w.ws.reserve(static_cast<int>(p));
+        w.lagSums.assign(p + 1, 0.0);
+        w.coefficients.reserve(p);
+        w.reversed.assign(p, 0.0);
+        w.forecast.assign(h, 0.0);
+    }
+
+    pool_.parallelFor(blocks, 1, [&](std::size_t beginBlock, std::size_t endBlock, int worker) {
+        WorkerScratch& w = scratch[worker];
+        double* R = w.lagSums.data();
+        for (std::size_t b = beginBlock; b < endBlock; ++b) {
+            BlockTotals& bt = totals[b];
+            bt.sumSq.assign(h, 0.0);
+            bt.sumAbsPct.assign(h, 0.0);
+
+            const std::size_t first = b * blockSize;
+            const std::size_t last = std::min(origins, first + blockSize);
+            std::size_t start = first * s; // window is x[start, start + W)
+            std::size_t sinceResync = 0;
+            SimdKernels::lagProducts(x + start, W, static_cast<int>(p), R);
+
+            for (std::size_t i = first; i < last; ++i) {
+                if (i > first) {
+                    sinceResync += s;
+                    if (!slide || sinceResync >= W) {
+                        start += s;
+                        sinceResync = 0;
+                        SimdKernels::lagProducts(x + start, W, static_cast<int>(p), R);
+                    } else {
+                        for (std::size_t k = 0; k < s; ++k, ++start) {
+                            // Oldest sample leaves, then the next one enters.
+                            const double* leaving = x + start;
+                            const double* entering = x + start + W;
+                            for (std::size_t l = 0; l <= p; ++l) {
+                                R[l] -= leaving[0] * leaving[l];
+                            }
+                            for (std::size_t l = 0; l <= p; ++l) {
+                                R[l] += entering[0] * entering[-static_cast<std::ptrdiff_t>(l)];
+                            }
+                        }
+                    }
+                }
+
+                const std::size_t t = start + W; // forecast origin
+                std::vector<double>& r = w.ws.autocorrelation;
+                r.resize(p + 1);
+                for (std::size_t l = 0; l <= p; ++l) {
+                    r[l] = R[l] / W;
+                }
+                // An all-zero window cannot be fitted. It is counted here and
+                // reported once by the caller: workers never print.
+                double errorVariance = 0.0;
+                if (r[0] == 0.0 ||
+                    !ARModel::yuleWalker(r, static_cast<int>(p), w.coefficients, &errorVariance, w.ws)) {
+                    ++bt.failed;
+                    continue;
+                }
+                std::reverse_copy(w.coefficients.begin(), w.coefficients.end(), w.reversed.begin());
+                w.ws.forecaster.reset(w.reversed.data(), static_cast<int>(p), x + t - p);
+                w.ws.forecaster.forecast(static_cast<int>(h), w.forecast.data());
+
+                double level = levels ? levels[t] : 0.0;
+                for (std::size_t j = 0; j < h; ++j) {
+                    double pred = w.forecast[j];
+                    double actual = x[t + j];
+                    if (levels) {
+                        level += pred;
+                        pred = level;
+                        actual = levels[t + j + 1];
+                    }
+                    w.forecast[j] = pred;
+                    double diff = pred - actual;
+                    bt.sumSq[j] += diff * diff;
+                    if (actual != 0.0) bt.sumAbsPct[j] += std::fabs(diff / actual) * 100.0;
+                }
+                if (options.keepForecasts) {
+                    std::copy(w.forecast.begin(), w.forecast.end(), result.forecasts.begin() + i * h);
+                }
+                ++bt.fitted;
+            }
+        }
+    });
+
+    // Reduce block by block in origin order.
+    std::vector<double> sumSq(h, 0.0), sumAbsPct(h, 0.0);
+    std::size_t fitted = 0;
+    for (const BlockTotals& bt : totals) {
+        for (std::size_t j = 0; j < h; ++j) {
+            sumSq[j] += bt.sumSq[j];
+            sumAbsPct[j] += bt.sumAbsPct[j];
+        }
+        fitted += bt.fitted;
+        result.failedFits += bt.failed;
+    }
+    double allSq = 0.0, allPct = 0.0;
+    result.byHorizon.resize(h);
+    for (std::size_t j = 0; j < h; ++j) {
+        result.byHorizon[j] = metricsFrom(sumSq[j], sumAbsPct[j], fitted);
+        allSq += sumSq[j];
+        allPct += sumAbsPct[j];
+    }
+    result.overall = metricsFrom(allSq, allPct, fitted * h);
+    if (result.failedFits > 0) {
+        std::cerr << "Walk-forward: " << result.failedFits << " of " << origins
+                  << " origins skipped (all-zero training window).\n";
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef WALK_FORWARD_BACKTESTER_H
+#define WALK_FORWARD_BACKTESTER_H
+
+#include <cstddef>
+#include <vector>
+#include "ErrorMetrics.h"
+#include "SeriesView.h"
+#include "ThreadPool.h"
+
+struct WalkForwardOptions {
+    int order = 1;
+    std::size_t window = 240;      // training samples per fit
+    std::size_t step = 1;          // samples the window slides between refits
+    int horizon = 20;              // forecast steps per origin
+    // Origins per parallel task. Each block starts from freshly computed lag
+    // sums; results depend on this, never on the thread count.
+    std::size_t blockOrigins = 256;
+    bool keepForecasts = false;    // store every forecast in the result
+};
+
+struct WalkForwardResult {
+    std::size_t origins = 0;            // forecast origins evaluated
+    std::size_t failedFits = 0;         // origins skipped (all-zero window);
+                                        // run() reports them once on std::cerr
+    ErrorMetrics overall {0.0, 0.0, 0.0};   // over every forecast point
+    std::vector<ErrorMetrics> byHorizon;    // [h]: (h+1)-step-ahead errors
+    // keepForecasts only: origins * horizon, row-major; rows of failed fits
+    // are NaN. The origin of row i is window + i * step.
+    std::vector<double> forecasts;
+};
+
+// Walk-forward backtest of a fixed-order AR model.
+//
+// The training window [t - window, t) slides by 'step' samples per origin t.
+// At each origin the model is refitted and 'horizon' forecasts are scored
+// against the following samples. The lag sums of the window are not
+// recomputed; the products of the samples that enter and leave are added and
+// subtracted, so a slide costs O(step * order), not O(window * order). Sums
+// are recomputed from scratch once per window length of sliding to bound
+// cancellation drift, as in StreamingARModel.
+//
+// Blocks of origins run in parallel and their error sums are reduced in
+// block order, so the result does not depend on the thread count.
+class WalkForwardBacktester {
+public:
+    explicit WalkForwardBacktester(int threads = 0);
+
+    // Scores forecasts of 'series' itself.
+    WalkForwardResult run(SeriesView series, const WalkForwardOptions& options);
+
+    // For a differenced series, levels[i + 1] = levels[i] + series[i]
+    // (levels.size() == series.size() + 1): forecasts are integrated from
+    // the level at the origin and scored against 'levels'.
+    WalkForwardResult run(SeriesView series, SeriesView levels, const WalkForwardOptions& options);
+
+    ThreadPool& pool() { return pool_; }
+
+private:
+    WalkForwardResult runImpl(SeriesView series, const double* levels, const WalkForwardOptions& options);
+
+    ThreadPool pool_;
+};
+
+#endif
@@ -1,176 +1,319 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <cctype>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include "AREstimator.h"
 #include "ARModel.h"
+#include "ArtifactWriter.h"
+#include "ErrorMetrics.h"
+#include "MonteCarloForecaster.h"
+#include "OrderSelector.h"
+#include "PanelIO.h"
 #include "SyntheticDataGenerator.h"
+#include "Trace.h"
+#include "Transforms.h"
 
-// Helper: write a vector of doubles to a file.
-void writeVectorToFile(const std::string &filename, const std::vector<double> &data) {
-    std::ofstream outFile(filename);
-    if (!outFile) {
-        std::cerr << "Error opening " << filename << " for writing.\n";
-        return;
-    }
-    for (double val : data) {
-        outFile << val << "\n";
-    }
-    outFile.close();
-}
-
-// Helper: write a single double to a file.
-void writeSingleValueToFile(const std::string &filename, double value) {
-    std::ofstream outFile(filename);
-    if (!outFile) {
-        std::cerr << "Error opening " << filename << " for writing.\n";
-        return;
+int main(int argc, char** argv) {
+    // --trace writes a Chrome-trace JSON of the instrumented phases and
+    // --metrics their latency histograms (Prometheus text format); both need
+    // a build configured with -DAR_ENABLE_TRACING=ON.
+    std::string tracePath, metricsPath;
+    // --estimator burg|covariance fits the candidate orders with Burg's method
+    // or the modified covariance method instead of Yule-Walker.
+    std::unique_ptr<AREstimator> estimator;
+    // --select aic|bic|hqic picks the order by information criterion instead
+    // of forecasting every candidate over the validation window (mse).
+    OrderCriterion criterion = OrderCriterion::ValidationMse;
+    std::string criterionName = "MSE";
+    // --mse-curve also scores every order on the validation window in
+    // criterion mode, for the MSE-vs-order plots (off: no forecasting).
+    bool mseCurve = false;
+    // --input FILE [--column NAME] forecasts one price column of a CSV or
+    // binary panel (.arpn) instead of the synthetic GBM series.
+    std::string inputPath, columnName;
+    // Artifacts go to one text file each by default; --binary writes the
+    // series as .bin files (SeriesIO/MappedSeries) and --output FILE collects
+    // the whole run in one container (.arc binary, or .csv with keys).
+    ArtifactWriter::Sink sink = ArtifactWriter::TextFiles;
+    std::string outputPath;
+    // --simulate N adds Monte Carlo prediction bands from N simulated paths.
+    int simulatePaths = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--binary") {
+            sink = ArtifactWriter::BinaryFiles;
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+            bool csv = outputPath.size() > 4 && outputPath.compare(outputPath.size() - 4, 4, ".csv") == 0;
+            sink = csv ? ArtifactWriter::Csv : ArtifactWriter::Container;
+        } else if ((arg == "--trace" || arg == "--metrics") && i + 1 < argc) {
+            (arg == "--trace" ? tracePath : metricsPath) = argv[++i];
+        } else if (arg == "--select" && i + 1 < argc) {
+            criterionName = argv[++i];
+            if (criterionName == "mse") {
+                criterion = OrderCriterion::ValidationMse;
+            } else if (criterionName == "aic") {
+                criterion = OrderCriterion::AIC;
+            } else if (criterionName == "bic") {
+                criterion = OrderCriterion::BIC;
+            } else if (criterionName == "hqic") {
+                criterion = OrderCriterion::HQIC;
+            } else {
+                std::cerr << "Unknown selection criterion: " << criterionName << " (mse, aic, bic or hqic)\n";
+                return 1;
+            }
+            for (char& c : criterionName) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        } else if (arg == "--mse-curve") {
+            mseCurve = true;
+        } else if (arg == "--simulate" && i + 1 < argc) {
+            simulatePaths = std::atoi(argv[++i]);
+        } else if (arg == "--input" && i + 1 < argc) {
+            inputPath = argv[++i];
+        } else if (arg == "--column" && i + 1 < argc) {
+            columnName = argv[++i];
+        } else if (arg == "--estimator" && i + 1 < argc) {
+            estimator = AREstimator::create(argv[++i]);
+            if (!estimator) {
+                std::cerr << "Unknown estimator: " << argv[i] << " (yule-walker, burg or covariance)\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: " << argv[0] << " [--binary | --output FILE] [--input FILE [--column NAME]] [--select mse|aic|bic|hqic [--mse-curve]]"
+                      << " [--estimator NAME] [--simulate PATHS] [--trace FILE] [--metrics FILE]\n";
+            return 1;
+        }
     }
-    outFile << value << "\n";
-    outFile.close();
-}
-
-// Structure for error metrics.
-struct ErrorMetrics {
-    double mse;
-    double rmse;
-    double mape;
-};
-
-ErrorMetrics computeErrors(const std::vector<double>& forecast, const std::vector<double>& actual) {
-    ErrorMetrics em {0.0, 0.0, 0.0};
-    if (forecast.size() != actual.size() || forecast.empty()) return em;
-    double sumSq = 0.0, sumAbsPct = 0.0;
-    for (size_t i = 0; i < forecast.size(); ++i) {
-        double diff = forecast[i] - actual[i];
-        sumSq += diff * diff;
-        if (actual[i] != 0.0)
-            sumAbsPct += std::fabs(diff / actual[i]) * 100.0;
+    if ((!tracePath.empty() || !metricsPath.empty()) && !Trace::compiledIn()) {
+        std::cerr << "Warning: built without AR_ENABLE_TRACING; trace output will be empty.\n";
     }
-    em.mse = sumSq / forecast.size();
-    em.rmse = std::sqrt(em.mse);
-    em.mape = sumAbsPct / forecast.size();
-    return em;
-}
+    Trace::setRecording(!tracePath.empty());
+    // Written on a background thread; the destructor flushes on early returns.
+    ArtifactWriter artifacts(sink, outputPath);
 
-int main() {
     // -------------------------------
-    // 1. Generate a Synthetic Price Series via GBM
+    // 1. Generate a Synthetic Price Series via GBM (or load one)
     // -------------------------------
     int totalDays = 300;      // Total data length
-    int trainDays = 240;      // Use first 260 days for training
-    int validDays = totalDays - trainDays; // Forecast horizon (e.g., 40 days)
     double S0 = 100.0;        // Initial stock price
     double mu = 0.01;         // Drift (adjust as needed)
     double sigma = 0.1;      // Volatility (adjust as needed)
     double deltaT = 1.0 / totalDays; // Time increment (using trainDays)
 
-    // Generate full synthetic price series.
-    std::vector<double> fullPrices = SyntheticDataGenerator::generateGBM(
-        totalDays, S0, mu, sigma, deltaT, 42
-    );
-    std::cout << "Generated " << fullPrices.size() << " synthetic GBM prices.\n";
-    writeVectorToFile("full_prices.txt", fullPrices);
+    std::vector<double> fullPrices;
+    if (inputPath.empty()) {
+        // Generate full synthetic price series.
+        fullPrices = SyntheticDataGenerator::generateGBM(totalDays, S0, mu, sigma, deltaT, 42);
+        std::cout << "Generated " << fullPrices.size() << " synthetic GBM prices.\n";
+    } else {
+        Panel panel;
+        bool binary = inputPath.size() > 5 && inputPath.compare(inputPath.size() - 5, 5, ".arpn") == 0;
+        ThreadPool loadPool;
+        if (!(binary ? PanelIO::readBinary(inputPath, panel) : PanelIO::readCsv(inputPath, panel, &loadPool))) {
+            return -1;
+        }
+        long column = columnName.empty() ? 0 : panel.find(columnName);
+        if (column < 0 || panel.columns() == 0) {
+            std::cerr << "Column " << columnName << " not found in " << inputPath << ".\n";
+            return -1;
+        }
+        SeriesView prices = panel.column(column);
+        for (double v : prices) {
+            if (!std::isfinite(v)) {
+                std::cerr << "Column " << panel.names[column] << " has missing or non-finite prices.\n";
+                return -1;
+            }
+        }
+        fullPrices.assign(prices.begin(), prices.end());
+        totalDays = static_cast<int>(fullPrices.size());
+        std::cout << "Loaded " << fullPrices.size() << " prices of " << panel.names[column]
+                  << " (" << panel.columns() << " columns) from " << inputPath << ".\n";
+    }
+    if (totalDays < 128) {
+        std::cerr << "Need at least 128 prices (got " << totalDays << ").\n";
+        return -1;
+    }
+    int validDays = totalDays / 5;         // Forecast horizon: the last fifth
+    int trainDays = totalDays - validDays; // Training window
+    artifacts.put("full_prices", fullPrices);
 
     // Split into training set (days 0 .. trainDays-1) and validation set (days trainDays .. totalDays-1).
     std::vector<double> trainPrices(fullPrices.begin(), fullPrices.begin() + trainDays);
     std::vector<double> validPrices(fullPrices.begin() + trainDays, fullPrices.end());
-    writeVectorToFile("train_prices.txt", trainPrices);
-    writeVectorToFile("actual_future_prices.txt", validPrices);
+    artifacts.put("train_prices", trainPrices);
+    artifacts.put("actual_future_prices", validPrices);
 
     // -------------------------------
     // 2. Transform Training Prices by Differencing
     // -------------------------------
     // Compute first differences: diff[i] = trainPrices[i+1] - trainPrices[i]
-    std::vector<double> diffData;
-    for (size_t i = 0; i < trainPrices.size() - 1; ++i) {
-        diffData.push_back(trainPrices[i+1] - trainPrices[i]);
-    }
+    std::vector<double> diffData = Transforms::difference(SeriesView(trainPrices));
     // Write differenced data to "log_returns.txt" (as expected by Python scripts)
-    writeVectorToFile("log_returns.txt", diffData);
+    artifacts.put("log_returns", diffData);
 
     // -------------------------------
     // 3. AR Model Order Selection over Differenced Data
     // -------------------------------
-    int maxOrder = 80;  // Try AR orders from 1 to 10.
+    int maxOrder = 80;  // Try AR orders from 20 to 80.
     std::vector<double> orders, mses, rmses, mapes;
-    double bestMse = std::numeric_limits<double>::infinity();
-    int bestOrder = 20;
-    std::vector<double> bestForecastedPrices;
 
     // Last training price (for integration)
     double lastTrainPrice = trainPrices.back();
 
-    for (int order = 20; order <= maxOrder; ++order) {
-        ARModel model(diffData, order);
-        if (!model.computeCoefficients()) {
-            orders.push_back(order);
-            mses.push_back(std::numeric_limits<double>::infinity());
-            rmses.push_back(std::numeric_limits<double>::infinity());
-            mapes.push_back(std::numeric_limits<double>::infinity());
-            continue;
+    // One autocorrelation pass and one Levinson-Durbin recursion yield every
+    // AR(k) solution up to maxOrder; each candidate just selects its order.
+    // The model only views diffData (no copy); diffData outlives it.
+    ARModel model(SeriesView(diffData), maxOrder);
+    LevinsonPath path;
+    bool pathOk = estimator ? model.fitAllOrders(maxOrder, path, *estimator)
+                            : model.fitAllOrders(maxOrder, path);
+
+    OrderSelectionOptions selectOptions;
+    selectOptions.minOrder = 20;
+    selectOptions.maxOrder = maxOrder;
+    OrderSelectionResult selection;
+    int bestOrder = 20;
+    if (criterion == OrderCriterion::ValidationMse) {
+        // Evaluate the candidate orders concurrently on the validation window.
+        OrderSelector selector;
+        if (pathOk) {
+            selection = selector.select(path, diffData, lastTrainPrice, validPrices, selectOptions);
+        } else {
+            for (int order = selectOptions.minOrder; order <= maxOrder; ++order) {
+                double inf = std::numeric_limits<double>::infinity();
+                selection.evaluations.push_back(OrderEvaluation {order, false, ErrorMetrics {inf, inf, inf}});
+            }
         }
-        // Forecast differenced values over the validation horizon.
-        std::vector<double> forecastedDiff = model.forwardPredictSteps(validDays);
-        // Reconstruct forecasted prices by integrating the forecasted differences.
-        std::vector<double> forecastedPrices(validDays);
-        double currentPrice = lastTrainPrice;
-        for (int i = 0; i < validDays; ++i) {
-            currentPrice += forecastedDiff[i];
-            forecastedPrices[i] = currentPrice;
+        for (const OrderEvaluation& ev : selection.evaluations) {
+            orders.push_back(ev.order);
+            mses.push_back(ev.metrics.mse);
+            rmses.push_back(ev.metrics.rmse);
+            mapes.push_back(ev.metrics.mape);
+        }
+        if (selection.bestOrder > 0) bestOrder = selection.bestOrder;
+        double bestMse = selection.bestOrder > 0 ? selection.bestMetrics.mse
+                                                 : std::numeric_limits<double>::infinity();
+
+        // Save AR order selection metrics for plotting.
+        artifacts.put("ar_orders", orders);
+        artifacts.put("ar_mses", std::move(mses));
+        artifacts.put("ar_rmses", std::move(rmses));
+        artifacts.put("ar_mapes", std::move(mapes));
+
+        std::cout << "Best AR order based on MSE: " << bestOrder << "\n";
+        std::cout << "MSE at best order: " << bestMse << "\n";
+    } else {
+        // Information criteria straight from the fitted e[k], over every
+        // order: no forecasting.
+        CriterionSelectionResult ic;
+        if (pathOk) {
+            ic = OrderSelector::selectByCriteria(path, diffData.size(), 1, maxOrder);
         }
-        // Compute error metrics (comparing forecastedPrices with validPrices).
-        ErrorMetrics em = computeErrors(forecastedPrices, validPrices);
-
-        orders.push_back(order);
-        mses.push_back(em.mse);
-        rmses.push_back(em.rmse);
-        mapes.push_back(em.mape);
-
-        // Keep forecast from the best model based on MSE.
-        if (em.mse < bestMse) {
-            bestMse = em.mse;
-            bestOrder = order;
-            bestForecastedPrices = forecastedPrices;
+        std::vector<double> aics, bics, hqics;
+        for (const CriterionValues& v : ic.values) {
+            orders.push_back(v.order);
+            aics.push_back(v.aic);
+            bics.push_back(v.bic);
+            hqics.push_back(v.hqic);
         }
-    }
+        if (ic.bestOrder(criterion) > 0) bestOrder = ic.bestOrder(criterion);
 
-    // Save AR order selection metrics for plotting.
-    writeVectorToFile("ar_orders.txt", orders);
-    writeVectorToFile("ar_mses.txt", mses);
-    writeVectorToFile("ar_rmses.txt", rmses);
-    writeVectorToFile("ar_mapes.txt", mapes);
+        artifacts.put("ar_orders", orders);
+        artifacts.put("ar_aic", std::move(aics));
+        artifacts.put("ar_bic", std::move(bics));
+        artifacts.put("ar_hqic", std::move(hqics));
 
-    std::cout << "Best AR order based on MSE: " << bestOrder << "\n";
-    std::cout << "MSE at best order: " << bestMse << "\n";
+        if (mseCurve) {
+            // The validation errors over the same orders, for plotting only.
+            OrderSelectionOptions curveOptions;
+            curveOptions.minOrder = 1;
+            curveOptions.maxOrder = maxOrder;
+            curveOptions.keepBestForecast = false;
+            OrderSelectionResult curve;
+            if (pathOk) {
+                OrderSelector selector;
+                curve = selector.select(path, diffData, lastTrainPrice, validPrices, curveOptions);
+            }
+            for (const OrderEvaluation& ev : curve.evaluations) {
+                mses.push_back(ev.metrics.mse);
+                rmses.push_back(ev.metrics.rmse);
+                mapes.push_back(ev.metrics.mape);
+            }
+            artifacts.put("ar_mses", std::move(mses));
+            artifacts.put("ar_rmses", std::move(rmses));
+            artifacts.put("ar_mapes", std::move(mapes));
+        } else if (sink == ArtifactWriter::TextFiles || sink == ArtifactWriter::BinaryFiles) {
+            // A previous MSE run's curves would not line up with this
+            // run's ar_orders.txt; plot_data.py skips the missing ones.
+            for (const char* key : {"ar_mses", "ar_rmses", "ar_mapes"}) {
+                std::remove((std::string(key) + ".txt").c_str());
+                std::remove((std::string(key) + ".bin").c_str());
+            }
+        }
+
+        std::cout << "Best AR order based on " << criterionName << ": " << bestOrder << "\n";
+    }
 
     // -------------------------------
     // 4. Output Forecasts using the Best AR Order
     // -------------------------------
-    // For best AR order, also output forecasted differences and integrated prices.
-    // (We re-run the forecast for clarity.)
-    ARModel bestModel(diffData, bestOrder);
-    if (!bestModel.computeCoefficients()) {
-        std::cerr << "Error computing best AR model coefficients.\n";
-        return -1;
-    }
-    std::vector<double> bestForecastedDiff = bestModel.forwardPredictSteps(validDays);
-    writeVectorToFile("forecasted_diff.txt", bestForecastedDiff);
-
-    // Reconstruct level forecasts.
-    std::vector<double> forecastedPrices(bestForecastedDiff.size());
-    double currentPrice = lastTrainPrice;
-    for (size_t i = 0; i < bestForecastedDiff.size(); ++i) {
-        currentPrice += bestForecastedDiff[i];
-        forecastedPrices[i] = currentPrice;
+    // The MSE selection pass kept the best order's forecast (differences and
+    // integrated prices), so nothing is refitted or re-forecast here.
+    std::vector<double> bestForecastedDiff, forecastedPrices;
+    bestForecastedDiff.swap(selection.bestForecast);
+    forecastedPrices.swap(selection.bestLevels);
+    if (selection.bestOrder == 0) {
+        // Chosen by an information criterion, or no order could be scored
+        // (then the default order): forecast it here.
+        if (!pathOk || !model.selectOrder(path, bestOrder)) {
+            std::cerr << "Error computing best AR model coefficients.\n";
+            return -1;
+        }
+        bestForecastedDiff = model.forwardPredictSteps(validDays);
+        forecastedPrices.resize(bestForecastedDiff.size());
+        Transforms::integrate(bestForecastedDiff.data(), bestForecastedDiff.size(), &lastTrainPrice,
+                              forecastedPrices.data());
     }
-    writeVectorToFile("forecasted_prices.txt", forecastedPrices);
+    artifacts.put("forecasted_diff", bestForecastedDiff);
+    artifacts.put("forecasted_prices", forecastedPrices);
 
-    // One-step forecast (optional).
-    double oneStepDiff = bestModel.forwardPredict();
+    // One-step forecast (optional): the first step of the multi-step forecast.
+    double oneStepDiff = bestForecastedDiff.empty() ? 0.0 : bestForecastedDiff[0];
     double oneStepPrice = lastTrainPrice + oneStepDiff;
-    writeSingleValueToFile("one_step_diff.txt", oneStepDiff);
-    writeSingleValueToFile("one_step_price.txt", oneStepPrice);
+    artifacts.put("one_step_diff", oneStepDiff);
+    artifacts.put("one_step_price", oneStepPrice);
+
+    // Prediction bands (optional): simulated price paths of the best order,
+    // with the 5%, 50% and 95% quantiles streamed per step.
+    if (simulatePaths > 0 && pathOk) {
+        const double* c = path.coefficientsFor(bestOrder);
+        MonteCarloForecaster monteCarlo(std::vector<double>(c, c + bestOrder), path.errorVariances[bestOrder]);
+        MonteCarloOptions mc;
+        mc.paths = simulatePaths;
+        mc.horizon = validDays;
+        mc.integrated = true;
+        mc.lastLevel = lastTrainPrice;
+        MonteCarloForecast bands;
+        ThreadPool simPool;
+        if (monteCarlo.simulate(diffData.data() + diffData.size() - bestOrder, mc, bands, &simPool)) {
+            std::vector<double> lower(validDays), median(validDays), upper(validDays);
+            for (int t = 0; t < validDays; ++t) {
+                lower[t] = bands.quantilesAt(t)[0];
+                median[t] = bands.quantilesAt(t)[1];
+                upper[t] = bands.quantilesAt(t)[2];
+            }
+            artifacts.put("forecast_p05", std::move(lower));
+            artifacts.put("forecast_p50", std::move(median));
+            artifacts.put("forecast_p95", std::move(upper));
+        }
+    }
 
     // -------------------------------
     // 5. Export Time Indices for Plotting
@@ -179,13 +322,13 @@ int main() {
     for (int i = 0; i < trainDays; ++i) {
         trainTime.push_back(i);
     }
-    writeVectorToFile("train_time_indices.txt", trainTime);
+    artifacts.put("train_time_indices", std::move(trainTime));
 
     std::vector<double> forecastTime;
     for (int i = 0; i < validDays; ++i) {
         forecastTime.push_back(trainDays + i);
     }
-    writeVectorToFile("forecast_time_indices.txt", forecastTime);
+    artifacts.put("forecast_time_indices", std::move(forecastTime));
 
     // -------------------------------
     // 6. Compute and Save Validation Error Metrics for Best Model
@@ -193,9 +336,9 @@ int main() {
     ErrorMetrics em_best = computeErrors(forecastedPrices, validPrices);
     std::cout << "Validation Error Metrics for Best Model (AR(" << bestOrder << ")):\n";
     std::cout << "MSE: " << em_best.mse << "\nRMSE: " << em_best.rmse << "\nMAPE: " << em_best.mape << "%\n";
-    writeSingleValueToFile("validation_mse.txt", em_best.mse);
-    writeSingleValueToFile("validation_rmse.txt", em_best.rmse);
-    writeSingleValueToFile("validation_mape.txt", em_best.mape);
+    artifacts.put("validation_mse", em_best.mse);
+    artifacts.put("validation_rmse", em_best.rmse);
+    artifacts.put("validation_mape", em_best.mape);
 
     // -------------------------------
     // 7. Print Summary
@@ -208,8 +351,14 @@ int main() {
     for (double p : forecastedPrices) {
         std::cout << p << " ";
     }
-    std::cout << "\nData saved to text files for plotting.\n";
+    if (!artifacts.close()) return -1;
+    std::string savedTo = sink == ArtifactWriter::TextFiles     ? "text files"
+                          : sink == ArtifactWriter::BinaryFiles ? ".bin files"
+                                                                : outputPath;
+    std::cout << "\nData saved to " << savedTo << " for plotting.\n";
 
+    if (!tracePath.empty()) Trace::writeChromeTrace(tracePath);
+    if (!metricsPath.empty()) Trace::writePrometheus(metricsPath);
     return 0;
 }
 
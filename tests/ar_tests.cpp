@@ -0,0 +1,92 @@
+// Correctness checks for the AR library, registered with ctest one check per
+// test (see CMakeLists.txt).
+//
+// Usage: ar_tests [NAME...]
+//
+// Runs the named checks, or all of them without arguments, and exits with
+// the first non-zero result (77 for a skipped check).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "ar_tests.h"
+
+// ---------------------------------------------------------------------------
+// Allocation counting: every global operator new in this process bumps it.
+// ---------------------------------------------------------------------------
+
+std::atomic<unsigned long long> g_allocations(0);
+volatile double g_sink = 0.0;
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct TestCase {
+    const char* name;
+    int (*run)();
+};
+
+const TestCase kTests[] = {
+    {"alloc_free", testAllocFree},
+    {"artifacts", testArtifacts},
+    {"estimators", testEstimators},
+    {"fixed_model", testFixedModel},
+    {"float_model", testFloatModel},
+    {"gpu_backend", testGpuBackend},
+    {"horizon_forecaster", testHorizonForecaster},
+    {"model_cache", testModelCache},
+    {"monte_carlo", testMonteCarlo},
+    {"panel_io", testPanelIo},
+    {"snapshots", testSnapshots},
+    {"trace_buckets", testTraceBuckets},
+    {"transforms", testTransforms},
+    {"var_model", testVarModel},
+    {"walk_forward", testWalkForward},
+};
+
+int runTest(const TestCase& t) {
+    std::printf("== %s\n", t.name);
+    std::fflush(stdout);
+    int rc = t.run();
+    std::fflush(stdout);
+    return rc;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int result = 0;
+    if (argc < 2) {
+        for (const TestCase& t : kTests) {
+            int rc = runTest(t);
+            if (result == 0 && rc != 0 && rc != kSkipped) result = rc;
+        }
+        return result;
+    }
+    for (int i = 1; i < argc; ++i) {
+        const TestCase* found = nullptr;
+        for (const TestCase& t : kTests) {
+            if (std::strcmp(t.name, argv[i]) == 0) found = &t;
+        }
+        if (!found) {
+            std::fprintf(stderr, "Unknown test '%s'. Available:", argv[i]);
+            for (const TestCase& t : kTests) std::fprintf(stderr, " %s", t.name);
+            std::fprintf(stderr, "\n");
+            return 1;
+        }
+        int rc = runTest(*found);
+        if (result == 0 && rc != 0) result = rc;
+    }
+    return result;
+}
@@ -0,0 +1,34 @@
+#ifndef AR_TESTS_H
+#define AR_TESTS_H
+
+#include <atomic>
+
+// Shared by the ar_tests checks (tests/ar_tests.cpp runs them).
+//
+// Every check prints one PASS/FAIL line per case and returns 0 when all of
+// them pass, 1 otherwise, or kSkipped when it cannot run on this machine.
+
+const int kSkipped = 77;
+
+// Global operator new calls in this process so far.
+extern std::atomic<unsigned long long> g_allocations;
+// Sink that keeps the optimizer from discarding results.
+extern volatile double g_sink;
+
+int testAllocFree();
+int testArtifacts();
+int testEstimators();
+int testFixedModel();
+int testFloatModel();
+int testGpuBackend();
+int testHorizonForecaster();
+int testModelCache();
+int testMonteCarlo();
+int testPanelIo();
+int testSnapshots();
+int testTraceBuckets();
+int testTransforms();
+int testVarModel();
+int testWalkForward();
+
+#endif
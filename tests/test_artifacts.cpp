@@ -0,0 +1,52 @@
+#include "ar_tests.h"
+#include "ArtifactWriter.h"
+#include "SyntheticDataGenerator.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Round-trip artifacts through both container sinks: every value must come
+// back bitwise, in order, with its key and scalar flag. The CSV keys include
+// commas, quotes and a line break, and the empty series must survive too.
+int testArtifacts() {
+    std::vector<Artifact> expected(5);
+    expected[0].key = "prices";
+    expected[0].values = SyntheticDataGenerator::generateGBM(100000, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    expected[1].key = "empty";
+    expected[2].key = "mse";
+    expected[2].values.assign(1, 1.0 / 3.0);
+    expected[2].scalar = true;
+    expected[3].key = "band \"p05\", lower";
+    expected[3].values.assign({1.5, -2.25});
+    expected[4].key = "two\nlines";
+    expected[4].values.assign(1, 4.0);
+    expected[4].scalar = true;
+
+    int failures = 0;
+    for (const char* path : {"ar_tests_artifacts.arc", "ar_tests_artifacts.csv"}) {
+        {
+            bool csv = std::string(path).find(".csv") != std::string::npos;
+            ArtifactWriter writer(csv ? ArtifactWriter::Csv : ArtifactWriter::Container, path);
+            for (const Artifact& a : expected) {
+                if (a.scalar) writer.put(a.key, a.values[0]);
+                else writer.put(a.key, a.values.data(), a.values.size());
+            }
+            failures += writer.close() ? 0 : 1;
+        }
+        std::vector<Artifact> got;
+        bool ok = ArtifactWriter::read(path, got) && got.size() == expected.size();
+        for (std::size_t i = 0; ok && i < expected.size(); ++i) {
+            const Artifact& e = expected[i];
+            const Artifact& g = got[i];
+            ok = g.key == e.key && g.scalar == e.scalar && g.values.size() == e.values.size() &&
+                 (e.values.empty() ||
+                  std::memcmp(g.values.data(), e.values.data(), e.values.size() * sizeof(double)) == 0);
+        }
+        failures += ok ? 0 : 1;
+        std::printf("%s  %s: %zu of %zu artifacts read back\n", ok ? "PASS" : "FAIL", path, got.size(),
+                    expected.size());
+        std::remove(path);
+    }
+    return failures == 0 ? 0 : 1;
+}
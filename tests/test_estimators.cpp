@@ -0,0 +1,143 @@
+#include "ar_tests.h"
+#include "AREstimator.h"
+#include "ARModel.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Solve A y = b in place (Gaussian elimination with partial pivoting).
+void denseSolve(std::vector<double>& A, std::vector<double>& b, int m) {
+    for (int c = 0; c < m; ++c) {
+        int piv = c;
+        for (int r = c + 1; r < m; ++r) {
+            if (std::abs(A[r * m + c]) > std::abs(A[piv * m + c])) piv = r;
+        }
+        for (int q = 0; q < m; ++q) std::swap(A[c * m + q], A[piv * m + q]);
+        std::swap(b[c], b[piv]);
+        for (int r = c + 1; r < m; ++r) {
+            double f = A[r * m + c] / A[c * m + c];
+            for (int q = c; q < m; ++q) A[r * m + q] -= f * A[c * m + q];
+            b[r] -= f * b[c];
+        }
+    }
+    for (int c = m - 1; c >= 0; --c) {
+        for (int q = c + 1; q < m; ++q) b[c] -= A[c * m + q] * b[q];
+        b[c] /= A[c * m + c];
+    }
+}
+
+double maxRelDiff(const double* a, const double* b, int k) {
+    double diff = 0.0, scale = 0.0;
+    for (int j = 0; j < k; ++j) {
+        diff = std::max(diff, std::abs(a[j] - b[j]));
+        scale = std::max(scale, std::abs(b[j]));
+    }
+    return scale > 0.0 ? diff / scale : diff;
+}
+
+} // namespace
+
+// Burg and modified covariance paths against independent references at every
+// order: the textbook Burg recursion with explicit denominators, and a dense
+// solve of the forward-backward least-squares normal equations. The
+// Yule-Walker estimator must equal ARModel::fitAllOrders() bit for bit.
+int testEstimators() {
+    const double kTolerance = 1e-10; // relative, coefficients and variances
+    const int maxOrder = 12;
+    int failures = 0;
+
+    for (int n : {500, 20000}) {
+        std::vector<double> prices = SyntheticDataGenerator::generateGBM(n + 1, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+        std::vector<double> x = Transforms::difference(SeriesView(prices));
+
+        // Yule-Walker through the estimator interface.
+        LevinsonPath yw, direct;
+        YuleWalkerEstimator ywEstimator;
+        bool ok = ywEstimator.fitPath(SeriesView(x), maxOrder, yw) &&
+                  ARModel(SeriesView(x), maxOrder).fitAllOrders(maxOrder, direct) &&
+                  yw.coefficients.size() == direct.coefficients.size() &&
+                  std::memcmp(yw.coefficients.data(), direct.coefficients.data(),
+                              direct.coefficients.size() * sizeof(double)) == 0 &&
+                  std::memcmp(yw.errorVariances.data(), direct.errorVariances.data(),
+                              direct.errorVariances.size() * sizeof(double)) == 0;
+        failures += ok ? 0 : 1;
+        std::printf("%s  yule-walker n=%d: path %s fitAllOrders()\n", ok ? "PASS" : "FAIL", n,
+                    ok ? "bitwise equal to" : "differs from");
+
+        // Burg reference: forward/backward errors kept explicitly.
+        LevinsonPath burg;
+        BurgEstimator burgEstimator;
+        ok = burgEstimator.fitPath(SeriesView(x), maxOrder, burg);
+        std::vector<double> f(x), b(x), a, next;
+        double e = 0.0;
+        for (double v : x) e += v * v;
+        e /= n;
+        double maxCoeff = 0.0, maxVar = 0.0;
+        for (int k = 1; ok && k <= maxOrder; ++k) {
+            double num = 0.0, den = 0.0;
+            for (int t = k; t < n; ++t) {
+                num += f[t] * b[t - 1];
+                den += f[t] * f[t] + b[t - 1] * b[t - 1];
+            }
+            double lambda = 2.0 * num / den;
+            for (int t = n - 1; t >= k; --t) {
+                double ft = f[t];
+                f[t] = ft - lambda * b[t - 1];
+                b[t] = b[t - 1] - lambda * ft;
+            }
+            next.assign(k, 0.0);
+            for (int j = 0; j < k - 1; ++j) next[j] = a[j] - lambda * a[k - 2 - j];
+            next[k - 1] = lambda;
+            a.swap(next);
+            e *= 1.0 - lambda * lambda;
+            maxCoeff = std::max(maxCoeff, maxRelDiff(burg.coefficientsFor(k), a.data(), k));
+            maxVar = std::max(maxVar, std::abs(burg.errorVariances[k] / e - 1.0));
+        }
+        ok = ok && maxCoeff <= kTolerance && maxVar <= kTolerance;
+        failures += ok ? 0 : 1;
+        std::printf("%s  burg n=%d, p=1..%d: max coefficient rel. diff %.3g, variance %.3g\n",
+                    ok ? "PASS" : "FAIL", n, maxOrder, maxCoeff, maxVar);
+
+        // Modified covariance reference: for each order k, minimize
+        // sum_{t=k}^{n-1} (x[t] - sum_j a_j x[t-j])^2 + (x[t-k] - sum_j a_j x[t-k+j])^2.
+        LevinsonPath cov;
+        ModifiedCovarianceEstimator covEstimator;
+        ok = covEstimator.fitPath(SeriesView(x), maxOrder, cov);
+        maxCoeff = 0.0;
+        maxVar = 0.0;
+        for (int k = 1; ok && k <= maxOrder; ++k) {
+            std::vector<double> A(k * k, 0.0), rhs(k, 0.0);
+            for (int t = k; t < n; ++t) {
+                for (int i = 1; i <= k; ++i) {
+                    rhs[i - 1] += x[t] * x[t - i] + x[t - k] * x[t - k + i];
+                    for (int j = 1; j <= k; ++j) {
+                        A[(i - 1) * k + j - 1] += x[t - i] * x[t - j] + x[t - k + i] * x[t - k + j];
+                    }
+                }
+            }
+            denseSolve(A, rhs, k);
+            double energy = 0.0;
+            for (int t = k; t < n; ++t) {
+                double fwd = x[t], bwd = x[t - k];
+                for (int j = 1; j <= k; ++j) {
+                    fwd -= rhs[j - 1] * x[t - j];
+                    bwd -= rhs[j - 1] * x[t - k + j];
+                }
+                energy += fwd * fwd + bwd * bwd;
+            }
+            maxCoeff = std::max(maxCoeff, maxRelDiff(cov.coefficientsFor(k), rhs.data(), k));
+            maxVar = std::max(maxVar, std::abs(cov.errorVariances[k] / (energy / (2.0 * (n - k))) - 1.0));
+        }
+        ok = ok && maxCoeff <= kTolerance && maxVar <= kTolerance;
+        failures += ok ? 0 : 1;
+        std::printf("%s  covariance n=%d, p=1..%d: max coefficient rel. diff %.3g, variance %.3g\n",
+                    ok ? "PASS" : "FAIL", n, maxOrder, maxCoeff, maxVar);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "FixedARModel.h"
+#include "SimdKernels.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// FixedARModel<P> runs ARModel's recursion in the same operation order, so
+// coefficients and error variances must match bit for bit. Forecasts sum the
+// dot product sequentially while ARModel uses the SIMD dot, whose vector body
+// starts at 4 terms on AVX2 and 8 on AVX-512: within a few ulp for every P.
+// Runs under each kernel ISA this CPU supports.
+int testFixedModel() {
+    const double kForecastTolerance = 1e-12; // relative
+    const int horizon = 200;
+    const SimdKernels::Isa saved = SimdKernels::activeIsa();
+    int failures = 0;
+
+    for (SimdKernels::Isa isa : {SimdKernels::Isa::AVX512, SimdKernels::Isa::AVX2, SimdKernels::Isa::Scalar}) {
+        SimdKernels::setIsa(isa);
+        if (SimdKernels::activeIsa() != isa) continue;
+        for (int n : {1000, 100000}) {
+            std::vector<double> prices = SyntheticDataGenerator::generateGBM(n + 1, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+            std::vector<double> x = Transforms::difference(SeriesView(prices));
+            const AutocorrelationMethod methods[] = {AutocorrelationMethod::Direct, AutocorrelationMethod::FFT};
+            for (AutocorrelationMethod method : methods) {
+                for (int p : {1, 2, 5, 10, 20}) {
+                    bool ran = withFixedOrder(p, [&](auto order) {
+                        constexpr int P = decltype(order)::value;
+                        ARModel model(SeriesView(x), P);
+                        FixedARModel<P> fixed((SeriesView(x)));
+                        model.setAutocorrelationMethod(method);
+                        fixed.setAutocorrelationMethod(method);
+                        bool ok = model.computeCoefficients() && fixed.computeCoefficients();
+                        double e = model.getErrorVariance(), eFixed = fixed.getErrorVariance();
+                        ok = ok && std::memcmp(model.getCoefficients().data(), fixed.getCoefficients().data(),
+                                               P * sizeof(double)) == 0 &&
+                             std::memcmp(&e, &eFixed, sizeof(double)) == 0;
+                        bool fitOk = ok;
+                        std::vector<double> f = model.forwardPredictSteps(horizon);
+                        std::vector<double> g = fixed.forwardPredictSteps(horizon);
+                        double maxRel = 0.0;
+                        for (int h = 0; ok && h < horizon; ++h) {
+                            double scale = std::max(std::abs(f[h]), 1e-300);
+                            maxRel = std::max(maxRel, std::abs(f[h] - g[h]) / scale);
+                        }
+                        ok = ok && maxRel <= kForecastTolerance;
+                        failures += ok ? 0 : 1;
+                        std::printf("%s  %-6s %s n=%d P=%d: coefficients %s, max forecast rel. diff %.3g\n",
+                                    ok ? "PASS" : "FAIL", SimdKernels::isaName(isa),
+                                    method == AutocorrelationMethod::FFT ? "fft   " : "direct", n, P,
+                                    fitOk ? "bitwise equal" : "differ", maxRel);
+                    });
+                    failures += ran ? 0 : 1;
+                }
+            }
+        }
+    }
+    SimdKernels::setIsa(saved);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Single-precision storage must track the double path closely: the only
+// difference is rounding the input samples to float.
+int testFloatModel() {
+    // Observed: up to ~4e-9 and ~1e-9; the bounds leave a small margin only,
+    // so a precision regression in the float path shows up.
+    const double kCoeffTolerance = 1e-7;   // max |phi_float - phi_double|
+    const double kMseTolerance = 1e-8;     // relative forecast-MSE difference
+    const int horizon = 50;
+    int failures = 0;
+
+    for (int n : {1000, 100000}) {
+        std::vector<double> prices = SyntheticDataGenerator::generateGBM(n + horizon + 1, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+        std::vector<double> x = Transforms::difference(SeriesView(prices));
+        SeriesView train(x.data(), n);
+        std::vector<float> trainF(train.begin(), train.end());
+
+        for (int p : {1, 10, 50}) {
+            ARModel model(train, p);
+            FloatARModel modelF(trainF, p);
+            if (!model.computeCoefficients() || !modelF.computeCoefficients()) {
+                ++failures;
+                continue;
+            }
+            double coeffDiff = 0.0;
+            for (int j = 0; j < p; ++j) {
+                coeffDiff = std::max(coeffDiff, std::abs(model.getCoefficients()[j] - modelF.getCoefficients()[j]));
+            }
+            std::vector<double> f = model.forwardPredictSteps(horizon);
+            std::vector<double> fF = modelF.forwardPredictSteps(horizon);
+            double mse = 0.0, mseF = 0.0;
+            for (int h = 0; h < horizon; ++h) {
+                double actual = x[n + h];
+                mse += (f[h] - actual) * (f[h] - actual);
+                mseF += (fF[h] - actual) * (fF[h] - actual);
+            }
+            double mseDiff = std::abs(mseF - mse) / mse;
+            bool ok = coeffDiff <= kCoeffTolerance && mseDiff <= kMseTolerance;
+            failures += ok ? 0 : 1;
+            std::printf("%s  n=%d p=%d: max coefficient diff %.3g, forecast MSE %.6g vs %.6g (rel diff %.3g)\n",
+                        ok ? "PASS" : "FAIL", n, p, coeffDiff, mseF / horizon, mse / horizon, mseDiff);
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "BatchFitter.h"
+#include "GpuBackend.h"
+#include "MonteCarloForecaster.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// CUDA backend against the CPU engine: batch-fit coefficients to rounding,
+// Monte Carlo moments to rounding and quantiles to within a couple of
+// histogram bins. The 100000 Monte Carlo paths take two launch chunks, one per
+// stream. Skipped when no device is usable.
+int testGpuBackend() {
+    if (!GpuBackend::available()) {
+        std::printf("SKIP  CUDA backend %s\n", GpuBackend::compiledIn() ? "has no usable device" : "not compiled in");
+        return kSkipped;
+    }
+    std::printf("Device: %s\n", GpuBackend::deviceName().c_str());
+    int failures = 0;
+
+    const int series = 300;
+    std::vector<std::vector<double> > data(series);
+    SeriesCollection collection;
+    for (int i = 0; i < series; ++i) {
+        std::vector<double> prices = SyntheticDataGenerator::generateGBM(5001 + 37 * i, 100.0, 0.01, 0.1, 1.0 / 252, 42 + i);
+        data[i] = Transforms::difference(SeriesView(prices));
+        collection.add(SeriesView(data[i]));
+    }
+    BatchFitter fitter;
+    for (int order : {1, 10, 200}) {
+        BatchFitResult cpu = fitter.fitBatch(collection, order, AutocorrelationMethod::Direct);
+        fitter.setBackend(ComputeBackend::Cuda);
+        BatchFitResult gpu = fitter.fitBatch(collection, order);
+        fitter.setBackend(ComputeBackend::Cpu);
+        double maxDiff = 0.0;
+        bool ok = gpu.count == cpu.count && gpu.ok == cpu.ok;
+        for (std::size_t i = 0; ok && i < cpu.coefficients.size(); ++i) {
+            maxDiff = std::max(maxDiff, std::abs(gpu.coefficients[i] - cpu.coefficients[i]));
+        }
+        for (std::size_t i = 0; ok && i < cpu.count; ++i) {
+            maxDiff = std::max(maxDiff, std::abs(gpu.errorVariances[i] - cpu.errorVariances[i]) /
+                                            std::max(cpu.errorVariances[i], 1e-300));
+        }
+        ok = ok && maxDiff < 1e-9;
+        failures += ok ? 0 : 1;
+        std::printf("%s  batch fit, %d series, p=%d: max diff from the CPU engine %.3g\n",
+                    ok ? "PASS" : "FAIL", series, order, maxDiff);
+    }
+
+    const SeriesView first(data[0]);
+    ARModel model(first, 10);
+    model.computeCoefficients();
+    MonteCarloForecaster engine(model);
+    MonteCarloOptions mc;
+    mc.paths = 100000;
+    mc.horizon = 100;
+    MonteCarloForecast cpu, gpu;
+    bool ok = engine.simulate(data[0].data() + data[0].size() - 10, mc, cpu);
+    mc.backend = ComputeBackend::Cuda;
+    ok = ok && engine.simulate(data[0].data() + data[0].size() - 10, mc, gpu);
+    double maxMean = 0.0, maxQuantile = 0.0;
+    for (int t = 0; ok && t < mc.horizon; ++t) {
+        // Bins span +-8 sd, so two bin widths is 32 sd / bins.
+        double sd = std::sqrt(cpu.variance[t]);
+        maxMean = std::max(maxMean, std::abs(gpu.mean[t] - cpu.mean[t]) / sd);
+        for (std::size_t j = 0; j < mc.probabilities.size(); ++j) {
+            maxQuantile = std::max(maxQuantile, std::abs(gpu.quantilesAt(t)[j] - cpu.quantilesAt(t)[j]) / sd);
+        }
+    }
+    ok = ok && maxMean < 1e-9 && maxQuantile < 32.0 / mc.bins;
+    failures += ok ? 0 : 1;
+    std::printf("%s  Monte Carlo, %d paths x %d steps: max mean diff %.3g sd, max quantile diff %.3g sd\n",
+                ok ? "PASS" : "FAIL", mc.paths, mc.horizon, maxMean, maxQuantile);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "HorizonForecaster.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Direct h-step forecasts against forwardPredictSteps() (plus integration
+// for levels) up to h = 300, within 1e-12 of the forecast scale. Level
+// variances are checked against psi-weights summed from the differenced
+// model's impulse response, within 1e-12 relative.
+int testHorizonForecaster() {
+    const double kTolerance = 1e-12;
+    const int maxHorizon = 300;
+    int failures = 0;
+
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(20001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+    std::vector<int> horizons(maxHorizon);
+    for (int h = 0; h < maxHorizon; ++h) horizons[h] = h + 1;
+
+    for (int p : {1, 5, 10, 50}) {
+        ARModel model(SeriesView(x), p);
+        if (!model.computeCoefficients()) {
+            ++failures;
+            continue;
+        }
+        const std::vector<double>& phi = model.getCoefficients();
+        const double sigma2 = model.getErrorVariance();
+        std::vector<double> steps = model.forwardPredictSteps(maxHorizon);
+
+        HorizonForecaster diffs(model), levels(model, true);
+        std::vector<HorizonForecast> d(maxHorizon), l(maxHorizon);
+        bool ok = diffs.forecast(x.data() + x.size() - p, horizons.data(), horizons.size(), d.data()) &&
+                  levels.forecast(prices.data() + prices.size() - (p + 1), horizons.data(), horizons.size(),
+                                  l.data());
+
+        // Impulse response of the differenced model; its running sums are
+        // the level model's psi-weights.
+        std::vector<double> psi(maxHorizon, 0.0);
+        psi[0] = 1.0;
+        for (int j = 1; j < maxHorizon; ++j) {
+            for (int i = 1; i <= std::min(j, p); ++i) psi[j] += phi[i - 1] * psi[j - i];
+        }
+        double maxDiff = 0.0, diffScale = 0.0, maxLevel = 0.0, levelScale = 0.0, maxVariance = 0.0;
+        double level = prices.back(), cum = 0.0, sumSq = 0.0;
+        for (int h = 0; ok && h < maxHorizon; ++h) {
+            maxDiff = std::max(maxDiff, std::abs(d[h].mean - steps[h]));
+            diffScale = std::max(diffScale, std::abs(steps[h]));
+            level += steps[h];
+            maxLevel = std::max(maxLevel, std::abs(l[h].mean - level));
+            levelScale = std::max(levelScale, std::abs(level));
+            cum += psi[h];
+            sumSq += cum * cum;
+            maxVariance = std::max(maxVariance, std::abs(l[h].variance / (sigma2 * sumSq) - 1.0));
+        }
+        double diffRel = diffScale > 0.0 ? maxDiff / diffScale : 0.0;
+        double levelRel = levelScale > 0.0 ? maxLevel / levelScale : 0.0;
+        ok = ok && diffRel <= kTolerance && levelRel <= kTolerance && maxVariance <= kTolerance;
+        failures += ok ? 0 : 1;
+        std::printf("%s  p=%d, h=1..%d: max diff %.3g (differenced), %.3g (levels), level variance rel. diff %.3g\n",
+                    ok ? "PASS" : "FAIL", p, maxHorizon, diffRel, levelRel, maxVariance);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "ModelCache.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <cstdio>
+#include <vector>
+
+// Orders are validated before the lookup: once a deep fit is cached, order 0,
+// negative orders and orders beyond the data are still refused, and no hit
+// is counted for them.
+int testModelCache() {
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(501, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+    const SeriesView data(x);
+    ModelCache cache;
+    CachedFit fit;
+    int failures = 0;
+
+    bool ok = cache.fit(data, 50, fit) && fit.coefficients.size() == 50;
+    failures += ok ? 0 : 1;
+    std::printf("%s  AR(50) fitted and cached\n", ok ? "PASS" : "FAIL");
+
+    for (int order : {0, -1, -50, 501}) {
+        const ModelCacheStats before = cache.stats();
+        ok = !cache.fit(data, order, fit);
+        ARModel model(data, order);
+        ok = ok && !cache.computeCoefficients(model);
+        const ModelCacheStats after = cache.stats();
+        ok = ok && after.hits == before.hits && after.misses == before.misses;
+        failures += ok ? 0 : 1;
+        std::printf("%s  order %d refused by fit() and computeCoefficients() without a lookup\n",
+                    ok ? "PASS" : "FAIL", order);
+    }
+
+    ok = cache.fit(data, 10, fit) && fit.coefficients.size() == 10 && cache.stats().hits == 1;
+    failures += ok ? 0 : 1;
+    std::printf("%s  AR(10) served from the cached AR(50) path\n", ok ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "CounterRng.h"
+#include "HorizonForecaster.h"
+#include "MonteCarloForecaster.h"
+#include "SyntheticDataGenerator.h"
+#include "ThreadPool.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Monte Carlo forecasts: bitwise independent of the thread count, equal to
+// a plain per-path simulation (mean) and close to its exact order-statistic
+// quantiles and to the analytic forecast-error variance.
+int testMonteCarlo() {
+    const int horizon = 60;
+    const int paths = 20000;
+    int failures = 0;
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(5001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+
+    for (int p : {1, 5, 20}) {
+        ARModel model(SeriesView(x), p);
+        if (!model.computeCoefficients()) {
+            ++failures;
+            continue;
+        }
+        const std::vector<double>& phi = model.getCoefficients();
+        const double sigma = std::sqrt(model.getErrorVariance());
+        const double* history = x.data() + x.size() - p;
+        MonteCarloForecaster engine(model);
+        MonteCarloOptions mc;
+        mc.paths = paths;
+        mc.horizon = horizon;
+        mc.integrated = true;
+        mc.lastLevel = prices.back();
+        MonteCarloForecast serial, parallel;
+        ThreadPool pool(4);
+        bool ok = engine.simulate(history, mc, serial) && engine.simulate(history, mc, parallel, &pool);
+        ok = ok && serial.quantiles == parallel.quantiles && serial.mean == parallel.mean &&
+             serial.variance == parallel.variance;
+
+        // Reference: every path on its own, stored in full.
+        std::vector<double> levels(static_cast<std::size_t>(paths) * horizon);
+        std::vector<double> z(horizon), window(p);
+        for (int k = 0; k < paths; ++k) {
+            CounterRng(mc.seed, k).normals(0, z.data(), horizon);
+            std::copy(history, history + p, window.begin());
+            double level = mc.lastLevel;
+            for (int t = 0; t < horizon; ++t) {
+                double v = 0.0;
+                for (int i = 1; i <= p; ++i) v += phi[i - 1] * window[p - i];
+                v += sigma * z[t];
+                std::rotate(window.begin(), window.begin() + 1, window.end());
+                window[p - 1] = v;
+                level += v;
+                levels[static_cast<std::size_t>(t) * paths + k] = level;
+            }
+        }
+        HorizonForecaster analytic(model, true);
+        double maxMeanDiff = 0.0, maxQuantileDiff = 0.0, maxVarianceRel = 0.0;
+        for (int t = 0; t < horizon; ++t) {
+            double* col = levels.data() + static_cast<std::size_t>(t) * paths;
+            double mean = 0.0;
+            for (int k = 0; k < paths; ++k) mean += col[k];
+            mean /= paths;
+            double sd = std::sqrt(serial.variance[t]);
+            maxMeanDiff = std::max(maxMeanDiff, std::abs(mean - serial.mean[t]) / sd);
+            std::sort(col, col + paths);
+            for (std::size_t j = 0; j < mc.probabilities.size(); ++j) {
+                double exact = col[static_cast<int>(mc.probabilities[j] * (paths - 1))];
+                maxQuantileDiff = std::max(maxQuantileDiff, std::abs(exact - serial.quantilesAt(t)[j]) / sd);
+            }
+            double variance = analytic.forecast(prices.data() + prices.size() - (p + 1), t + 1).variance;
+            maxVarianceRel = std::max(maxVarianceRel, std::abs(serial.variance[t] / variance - 1.0));
+        }
+        // One bin is 16 / 2048 sd; sampling error of the variance is ~1%.
+        ok = ok && maxMeanDiff < 1e-9 && maxQuantileDiff < 0.05 && maxVarianceRel < 0.05;
+        failures += ok ? 0 : 1;
+        std::printf("%s  p=%d: %d paths x %d steps; max |mean diff| %.2g sd, max |quantile diff| %.3g sd, "
+                    "max variance rel. error %.3g\n",
+                    ok ? "PASS" : "FAIL", p, paths, horizon, maxMeanDiff, maxQuantileDiff, maxVarianceRel);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include "ar_tests.h"
+#include "PanelIO.h"
+#include "ThreadPool.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool writeText(const char* path, const std::string& text) {
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+double referenceParse(const std::string& token) {
+    double value = 0.0;
+#if defined(__cpp_lib_to_chars)
+    std::from_chars(token.data(), token.data() + token.size(), value);
+#else
+    value = std::strtod(token.c_str(), nullptr);
+#endif
+    return value;
+}
+
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+// Overwrite the header of an existing binary panel file.
+bool patchHeader(const char* path, const PanelFileHeader& h) {
+    std::FILE* f = std::fopen(path, "r+b");
+    if (!f) return false;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    return (std::fclose(f) == 0) && ok;
+}
+
+} // namespace
+
+// readCsv must agree bitwise with std::from_chars on every field, whether a
+// field takes the Clinger fast path or the general parser, and give the same
+// panel for one chunk or many. Layout quirks (CRLF, blank lines, leading
+// non-numeric columns, empty fields) are accepted, wrong field counts are
+// refused, and corrupt binary headers are refused without a huge allocation.
+int testPanelIo() {
+    const char* csvPath = "ar_tests_panel.csv";
+    const char* binPath = "ar_tests_panel.arpn";
+    int failures = 0;
+
+    // Several MB so the pool run really splits the body into chunks. The
+    // formats mix fast-path fields (short decimals, integers, small
+    // exponents) with ones that need the general parser (17 and 25 digits,
+    // exponents beyond 1e+-22).
+    const std::size_t columns = 5, rows = 40000;
+    const char* formats[columns] = {"%.6f", "%.17g", "%.3e", "%.25f", "%.15g"};
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::string text = "a,b,c,d,e\n";
+    Panel expected;
+    expected.rows = rows;
+    expected.names = {"a", "b", "c", "d", "e"};
+    expected.values.resize(columns * rows);
+    char token[64];
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < columns; ++c) {
+            double scale = std::pow(10.0, static_cast<double>(static_cast<int>(rng() % 61) - 30));
+            double v = r % 97 == 0 ? static_cast<double>(rng() % 100000) : uniform(rng) * scale;
+            int n = std::snprintf(token, sizeof(token), formats[c], v);
+            expected.values[c * rows + r] = referenceParse(std::string(token, n));
+            text.append(token, n);
+            text += c + 1 == columns ? '\n' : ',';
+        }
+    }
+    bool ok = writeText(csvPath, text);
+    ThreadPool pool(4);
+    for (ThreadPool* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        Panel got;
+        bool read = ok && PanelIO::readCsv(csvPath, got, p);
+        bool same = read && got.rows == rows && got.names == expected.names && sameBits(got.values, expected.values);
+        failures += same ? 0 : 1;
+        std::printf("%s  %zu x %zu CSV, %s: bitwise equal to std::from_chars\n", same ? "PASS" : "FAIL", rows,
+                    columns, p ? "4 threads" : "1 thread");
+    }
+
+    // CRLF line ends, blank lines, two skipped leading columns, an empty field.
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        Panel got;
+        ok = writeText(csvPath,
+                       "date,id,\"x\",y\r\n2020-01-01,a,1.5,2\r\n\r\n  \t\n2020-01-02,b,,3e2\r\n\n"
+                       "2020-01-03,c,-0.25, 4 \r\n") &&
+             PanelIO::readCsv(csvPath, got);
+        const std::vector<double> want = {1.5, nan, -0.25, 2.0, 300.0, 4.0};
+        ok = ok && got.rows == 3 && got.names == std::vector<std::string>{"x", "y"} && got.values.size() == 6;
+        for (std::size_t i = 0; ok && i < want.size(); ++i) {
+            ok = std::isnan(want[i]) ? std::isnan(got.values[i]) : got.values[i] == want[i];
+        }
+        failures += ok ? 0 : 1;
+        std::printf("%s  CRLF, blank lines, skipped leading columns and empty fields\n", ok ? "PASS" : "FAIL");
+    }
+
+    struct Malformed {
+        const char* text;
+        const char* what;
+    };
+    const Malformed malformed[] = {
+        {"x,y\n1,2\n3\n", "missing field"},
+        {"x,y\n1,2\n3,4,5\n", "extra field"},
+        {"x,y\n1,2\n3,oops\n", "non-numeric field"},
+    };
+    for (const Malformed& m : malformed) {
+        Panel got;
+        got.rows = 1;
+        ok = writeText(csvPath, m.text) && !PanelIO::readCsv(csvPath, got) && got.rows == 0 && got.values.empty();
+        failures += ok ? 0 : 1;
+        std::printf("%s  malformed row refused: %s\n", ok ? "PASS" : "FAIL", m.what);
+    }
+    std::remove(csvPath);
+
+    // Binary round trip, then the same file with corrupt or truncated headers.
+    {
+        Panel got;
+        ok = PanelIO::writeBinary(binPath, expected) && PanelIO::readBinary(binPath, got) &&
+             got.rows == expected.rows && got.names == expected.names && sameBits(got.values, expected.values);
+        failures += ok ? 0 : 1;
+        std::printf("%s  binary panel round trip\n", ok ? "PASS" : "FAIL");
+    }
+    PanelFileHeader good;
+    {
+        std::FILE* f = std::fopen(binPath, "rb");
+        ok = f && std::fread(&good, sizeof(good), 1, f) == 1;
+        if (f) std::fclose(f);
+    }
+    struct Corruption {
+        const char* what;
+        void (*apply)(PanelFileHeader&);
+    };
+    const Corruption corruptions[] = {
+        {"bad magic", [](PanelFileHeader& h) { h.magic[0] = 'X'; }},
+        {"names block larger than the file", [](PanelFileHeader& h) { h.namesBytes = ~std::uint64_t(0) - 63; }},
+        {"rows * columns wraps to zero",
+         [](PanelFileHeader& h) {
+             h.rows = std::uint64_t(1) << 62;
+             h.columns = 8;
+         }},
+        {"one row too many", [](PanelFileHeader& h) { h.rows += 1; }},
+    };
+    for (const Corruption& c : corruptions) {
+        PanelFileHeader h = good;
+        c.apply(h);
+        Panel got;
+        bool refused = ok && patchHeader(binPath, h) && !PanelIO::readBinary(binPath, got) && got.values.empty();
+        failures += refused ? 0 : 1;
+        std::printf("%s  corrupt header refused: %s\n", refused ? "PASS" : "FAIL", c.what);
+    }
+    {
+        // Drop the last value: the header now promises more than the file holds.
+        std::vector<char> bytes(sizeof(good) + good.namesBytes + columns * rows * sizeof(double));
+        std::FILE* f = ok && patchHeader(binPath, good) ? std::fopen(binPath, "rb") : nullptr;
+        ok = f && std::fread(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        if (f) std::fclose(f);
+        Panel got;
+        bool refused = ok && writeText(binPath, std::string(bytes.data(), bytes.size() - sizeof(double))) &&
+                       !PanelIO::readBinary(binPath, got) && got.values.empty();
+        failures += refused ? 0 : 1;
+        std::printf("%s  truncated payload refused\n", refused ? "PASS" : "FAIL");
+    }
+    std::remove(binPath);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "ModelSnapshot.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Snapshot publishing under a refit thread: every snapshot a reader acquires
+// is internally consistent (never freed or half-built), versions only move
+// forward, everything retired is reclaimed once readers go idle, and a null
+// snapshot is refused. Also reports reader latency against a mutex held across each refit.
+int testSnapshots() {
+    const int readers = 3, order = 16, updates = 20000;
+    int failures = 0;
+
+    SnapshotPublisher publisher;
+    std::atomic<bool> done(false);
+    std::atomic<long long> bad(0), reads(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; ++t) {
+        threads.emplace_back([&] {
+            SnapshotPublisher::Reader reader = publisher.registerReader();
+            std::vector<double> ones(order, 1.0);
+            std::uint64_t last = 0;
+            long long n = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                SnapshotPublisher::Guard g = reader.acquire();
+                if (!g) continue;
+                // Snapshot v has every coefficient equal to v.
+                double v = static_cast<double>(g->version);
+                bool ok = g->version >= last && g->order == order &&
+                          g->forwardPredict(ones.data()) == order * v;
+                for (int j = 0; ok && j < order; ++j) {
+                    ok = g->coefficients[j] == v && g->reversedCoefficients[j] == v;
+                }
+                if (!ok) bad.fetch_add(1);
+                last = g->version;
+                ++n;
+            }
+            reads.fetch_add(n);
+        });
+    }
+    for (int v = 1; v <= updates; ++v) {
+        publisher.publish(ModelSnapshot::fromCoefficients(std::vector<double>(order, v), 1.0));
+        if (v % 64 == 0) std::this_thread::yield();
+    }
+    done.store(true);
+    for (std::thread& t : threads) t.join();
+    publisher.reclaim();
+    bool ok = bad.load() == 0 && publisher.version() == static_cast<std::uint64_t>(updates) &&
+              publisher.pendingReclaim() == 0;
+    failures += ok ? 0 : 1;
+    std::printf("%s  %d publishes, %lld reads by %d readers: %lld inconsistent, %zu left unreclaimed\n",
+                ok ? "PASS" : "FAIL", updates, reads.load(), readers, bad.load(),
+                publisher.pendingReclaim());
+
+    ok = publisher.publish(std::unique_ptr<ModelSnapshot>()) == 0 &&
+         publisher.version() == static_cast<std::uint64_t>(updates);
+    failures += ok ? 0 : 1;
+    std::printf("%s  null snapshot refused, version stays %d\n", ok ? "PASS" : "FAIL", updates);
+
+    // Reader latency while a writer keeps refitting AR(32) on 10^5 samples,
+    // once behind a mutex around the model and once through snapshots.
+    typedef std::chrono::steady_clock Clock;
+    const int p = 32, refits = 20;
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(100001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+    for (int mode = 0; mode < 2; ++mode) {
+        const bool useSnapshots = mode == 1;
+        ARModel shared(SeriesView(x), p);
+        shared.computeCoefficients();
+        std::mutex mutex;
+        SnapshotPublisher models;
+        models.publish(shared);
+        done.store(false);
+        std::vector<std::vector<double> > latencies(readers);
+        threads.clear();
+        for (int t = 0; t < readers; ++t) {
+            threads.emplace_back([&, t] {
+                SnapshotPublisher::Reader reader = models.registerReader();
+                const double* window = x.data() + x.size() - p;
+                while (!done.load(std::memory_order_relaxed)) {
+                    Clock::time_point t0 = Clock::now();
+                    double y = 0.0;
+                    if (useSnapshots) {
+                        reader.forwardPredict(window, y);
+                    } else {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        y = shared.forwardPredict();
+                    }
+                    g_sink = y;
+                    latencies[t].push_back(std::chrono::duration<double>(Clock::now() - t0).count());
+                }
+            });
+        }
+        for (int r = 0; r < refits; ++r) {
+            if (useSnapshots) {
+                ARModel refit(SeriesView(x), p);
+                refit.computeCoefficients();
+                models.publish(refit);
+            } else {
+                std::lock_guard<std::mutex> lock(mutex);
+                shared.computeCoefficients();
+            }
+            std::this_thread::yield();
+        }
+        done.store(true);
+        for (std::thread& t : threads) t.join();
+        std::vector<double> all;
+        for (const std::vector<double>& l : latencies) all.insert(all.end(), l.begin(), l.end());
+        std::sort(all.begin(), all.end());
+        double p99 = all.empty() ? 0.0 : all[all.size() * 99 / 100];
+        double worst = all.empty() ? 0.0 : all.back();
+        std::printf("INFO  %s: %zu predictions during %d refits, p99 %.3g us, max %.3g us\n",
+                    useSnapshots ? "snapshot readers" : "mutex readers   ", all.size(), refits,
+                    p99 * 1e6, worst * 1e6);
+    }
+    return failures == 0 ? 0 : 1;
+}
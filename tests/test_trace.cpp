@@ -0,0 +1,33 @@
+#include "ar_tests.h"
+#include "Trace.h"
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+// Histogram buckets are inclusive at their upper bound, as the Prometheus
+// 'le' labels say: a duration of exactly 2^(k + 8) ns lands in bucket k.
+// Trace::record() collects in every build, so this runs without tracing.
+int testTraceBuckets() {
+    Trace::reset();
+    const int phase = Trace::registerPhase("test.buckets");
+    for (std::uint64_t ns : {0ull, 256ull, 257ull, 512ull, 513ull, 1024ull}) Trace::record(phase, 0, ns);
+    std::ostringstream out;
+    Trace::writePrometheus(out);
+    const std::string text = out.str();
+
+    struct Expected {
+        const char* le;
+        int cumulative;
+    };
+    const Expected expected[] = {{"2.56e-07", 2}, {"5.12e-07", 4}, {"1.024e-06", 6}, {"+Inf", 6}};
+    int failures = 0;
+    for (const Expected& e : expected) {
+        std::string line = std::string("ar_phase_seconds_bucket{phase=\"test.buckets\",le=\"") + e.le + "\"} " +
+                           std::to_string(e.cumulative) + "\n";
+        bool ok = text.find(line) != std::string::npos;
+        failures += ok ? 0 : 1;
+        std::printf("%s  le=%s holds %d of 6 durations\n", ok ? "PASS" : "FAIL", e.le, e.cumulative);
+    }
+    Trace::reset();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include "ar_tests.h"
+#include "PanelIO.h"
+#include "SyntheticDataGenerator.h"
+#include "ThreadPool.h"
+#include "Transforms.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// The in-place panel apply() must give exactly the out-of-place result, and
+// the panel integrateLog() must undo log-returns to rounding.
+int testTransforms() {
+    const double kLevelTolerance = 1e-12;   // relative, after integrateLog()
+    const std::size_t columns = 11, rows = 500;
+    Panel levels;
+    levels.rows = rows;
+    for (std::size_t c = 0; c < columns; ++c) levels.names.push_back("s" + std::to_string(c));
+    levels.values = SyntheticDataGenerator::generateGBMPaths(static_cast<int>(columns), static_cast<int>(rows),
+                                                             100.0, 0.05, 0.2, 1.0 / 252, 7);
+    ThreadPool pool(4);
+    int failures = 0;
+
+    for (SeriesTransform transform : {SeriesTransform::Difference, SeriesTransform::LogReturn}) {
+        const char* name = transform == SeriesTransform::Difference ? "difference" : "log-return";
+        for (std::size_t lag : {1, 5}) {
+            Panel expected;
+            Transforms::apply(transform, levels, expected, lag, &pool);
+            Panel inPlace = levels;
+            Transforms::apply(transform, inPlace, lag, &pool);
+            bool ok = inPlace.rows == expected.rows && inPlace.values == expected.values &&
+                      inPlace.names == expected.names;
+            failures += ok ? 0 : 1;
+            std::printf("%s  in-place %s, lag %zu: bitwise equal to the out-of-place panel\n",
+                        ok ? "PASS" : "FAIL", name, lag);
+            if (transform != SeriesTransform::LogReturn) continue;
+
+            // Seeds are each column's first lag levels; the scan rebuilds the rest.
+            std::vector<double> seeds(columns * lag);
+            for (std::size_t c = 0; c < columns; ++c) {
+                std::copy(levels.values.begin() + c * rows, levels.values.begin() + c * rows + lag,
+                          seeds.begin() + c * lag);
+            }
+            Transforms::integrateLog(inPlace, seeds.data(), inPlace, lag, &pool);
+            double worst = 0.0;
+            for (std::size_t c = 0; c < columns; ++c) {
+                for (std::size_t i = 0; i < inPlace.rows; ++i) {
+                    double want = levels.values[c * rows + i + lag];
+                    worst = std::max(worst, std::abs(inPlace.values[c * inPlace.rows + i] - want) / want);
+                }
+            }
+            ok = worst <= kLevelTolerance;
+            failures += ok ? 0 : 1;
+            std::printf("%s  integrateLog panel, lag %zu: max relative level error %.3g (tolerance %.0e)\n",
+                        ok ? "PASS" : "FAIL", lag, worst, kLevelTolerance);
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
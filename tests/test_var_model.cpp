@@ -0,0 +1,164 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "CounterRng.h"
+#include "VARModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Written against ARModel's forecasting calls only, as generic code over
+// the model type would be.
+template <class Model>
+std::vector<double> forecastOf(const Model& model, int steps, double& errorVariance) {
+    errorVariance = model.getErrorVariance();
+    std::vector<double> f = model.forwardPredictSteps(steps);
+    if (!f.empty() && model.forwardPredict() != f[0]) f.clear();
+    return f;
+}
+
+} // namespace
+
+// VAR fits: the Whittle recursion against a dense solve of the block
+// Yule-Walker system, recovery of known coefficients from a simulated
+// VAR(2), the ring-buffer forecast against the plain recurrence, and the
+// per-series VARComponent views against the full forecast.
+int testVarModel() {
+    const int k = 3, p = 2;
+    const std::size_t n = 200000;
+    // Stable VAR(2) with cross-series terms.
+    const double A[p][k][k] = {{{0.5, 0.1, 0.0}, {-0.2, 0.3, 0.1}, {0.0, 0.2, 0.4}},
+                               {{-0.2, 0.0, 0.05}, {0.1, -0.1, 0.0}, {0.0, 0.05, 0.1}}};
+    std::vector<double> columns(k * n, 0.0);
+    std::vector<double> z(2 * k);
+    for (std::size_t t = p; t < n; ++t) {
+        CounterRng(7, 0).normals(t * k, z.data(), k);
+        for (int i = 0; i < k; ++i) {
+            double v = z[i];
+            for (int lag = 1; lag <= p; ++lag) {
+                for (int j = 0; j < k; ++j) v += A[lag - 1][i][j] * columns[j * n + t - lag];
+            }
+            columns[i * n + t] = v;
+        }
+    }
+    int failures = 0;
+
+    // Dense reference for a higher order: solve [A_1..A_P] R = [G(1)..G(P)]
+    // with R's block (j, l) = Gamma(l - j), Gamma(-h) = Gamma(h)^T.
+    const int P = 6;
+    std::vector<double> gamma, coeffs, sigma;
+    VARModel::autocovariances(columns.data(), n, k, P, gamma);
+    bool ok = VARModel::whittle(gamma, k, P, coeffs, sigma);
+    const int m = P * k;
+    std::vector<double> R(m * m), G(k * m);
+    auto gammaAt = [&](int h, int i, int j) {
+        return h >= 0 ? gamma[h * k * k + i * k + j] : gamma[-h * k * k + j * k + i];
+    };
+    for (int bj = 0; bj < P; ++bj) {
+        for (int bl = 0; bl < P; ++bl) {
+            for (int i = 0; i < k; ++i) {
+                for (int j = 0; j < k; ++j) R[(bj * k + i) * m + bl * k + j] = gammaAt(bl - bj, i, j);
+            }
+        }
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j) G[i * m + bj * k + j] = gammaAt(bj + 1, i, j);
+        }
+    }
+    // Row i of X solves X_i R = G_i, i.e. R^T X_i^T = G_i^T (Gaussian elimination).
+    double maxDense = 0.0;
+    for (int i = 0; ok && i < k; ++i) {
+        std::vector<double> M(m * (m + 1));
+        for (int r = 0; r < m; ++r) {
+            for (int c = 0; c < m; ++c) M[r * (m + 1) + c] = R[c * m + r];
+            M[r * (m + 1) + m] = G[i * m + r];
+        }
+        for (int c = 0; c < m; ++c) {
+            int piv = c;
+            for (int r = c + 1; r < m; ++r) {
+                if (std::abs(M[r * (m + 1) + c]) > std::abs(M[piv * (m + 1) + c])) piv = r;
+            }
+            for (int q = 0; q <= m; ++q) std::swap(M[c * (m + 1) + q], M[piv * (m + 1) + q]);
+            for (int r = 0; r < m; ++r) {
+                if (r == c) continue;
+                double f = M[r * (m + 1) + c] / M[c * (m + 1) + c];
+                for (int q = c; q <= m; ++q) M[r * (m + 1) + q] -= f * M[c * (m + 1) + q];
+            }
+        }
+        for (int lag = 0; lag < P; ++lag) {
+            for (int j = 0; j < k; ++j) {
+                double dense = M[(lag * k + j) * (m + 1) + m] / M[(lag * k + j) * (m + 1) + lag * k + j];
+                maxDense = std::max(maxDense, std::abs(dense - coeffs[lag * k * k + i * k + j]));
+            }
+        }
+    }
+    ok = ok && maxDense < 1e-10;
+    failures += ok ? 0 : 1;
+    std::printf("%s  whittle vs dense solve, k=%d P=%d: max coefficient diff %.3g\n",
+                ok ? "PASS" : "FAIL", k, P, maxDense);
+
+    // The fitted VAR(2) recovers the generating coefficients and unit noise.
+    VARModel model(columns.data(), n, k, p);
+    ok = model.computeCoefficients();
+    double maxTrue = 0.0, maxSigma = 0.0;
+    for (int lag = 1; ok && lag <= p; ++lag) {
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j) {
+                maxTrue = std::max(maxTrue, std::abs(model.coefficientsFor(lag)[i * k + j] - A[lag - 1][i][j]));
+                double s = i == j ? 1.0 : 0.0;
+                maxSigma = std::max(maxSigma, std::abs(model.getErrorCovariance()[i * k + j] - s));
+            }
+        }
+    }
+    ok = ok && maxTrue < 0.02 && maxSigma < 0.02;
+    failures += ok ? 0 : 1;
+    std::printf("%s  VAR(%d) recovery, n=%zu: max coefficient error %.3g, max covariance error %.3g\n",
+                ok ? "PASS" : "FAIL", p, n, maxTrue, maxSigma);
+
+    // Ring-buffer forecasts against the recurrence on a growing copy.
+    const int steps = 50;
+    std::vector<double> f = model.forwardPredictSteps(steps);
+    std::vector<double> hist;
+    for (std::size_t t = n - p; t < n; ++t) {
+        for (int c = 0; c < k; ++c) hist.push_back(columns[c * n + t]);
+    }
+    double maxForecast = 0.0;
+    for (int s = 0; ok && s < steps; ++s) {
+        for (int i = 0; i < k; ++i) {
+            double v = 0.0;
+            for (int lag = 1; lag <= p; ++lag) {
+                for (int j = 0; j < k; ++j) {
+                    v += model.coefficientsFor(lag)[i * k + j] * hist[hist.size() - lag * k + j];
+                }
+            }
+            maxForecast = std::max(maxForecast, std::abs(v - f[s * k + i]));
+            z[i] = v;
+        }
+        hist.insert(hist.end(), z.begin(), z.begin() + k);
+    }
+    ok = ok && f.size() == static_cast<std::size_t>(steps * k) && maxForecast < 1e-12;
+    failures += ok ? 0 : 1;
+    std::printf("%s  VAR forecast, %d steps: max diff from the recurrence %.3g\n",
+                ok ? "PASS" : "FAIL", steps, maxForecast);
+
+    // Each component view returns its column of the step-major forecast.
+    ok = true;
+    for (int c = 0; c < k; ++c) {
+        double variance = 0.0;
+        std::vector<double> fc = forecastOf(model.component(c), steps, variance);
+        ok = ok && fc.size() == static_cast<std::size_t>(steps) &&
+             variance == model.getErrorCovariance()[c * k + c];
+        for (int s = 0; ok && s < steps; ++s) ok = fc[s] == f[s * k + c];
+    }
+    ok = ok && model.component(k).forwardPredictSteps(steps).empty();
+    // The same helper takes an ARModel of one series.
+    ARModel ar(SeriesView(columns.data(), n), p);
+    double arVariance = 0.0;
+    ok = ok && ar.computeCoefficients() && forecastOf(ar, steps, arVariance) == ar.forwardPredictSteps(steps) &&
+         arVariance == ar.getErrorVariance();
+    failures += ok ? 0 : 1;
+    std::printf("%s  VARComponent views through ARModel's forecasting calls: bitwise the VAR forecast columns\n",
+                ok ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include "WalkForwardBacktester.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Walk-forward backtests against a full ARModel refit at every origin: the
+// slid lag sums must give the same forecasts, differenced and integrated, to
+// within 1e-13 of the forecast scale, and the same level-space MSE. Results
+// must also be bitwise independent of the thread count.
+int testWalkForward() {
+    const double kForecastTolerance = 1e-13; // max |diff| / max |forecast|
+    const double kMseTolerance = 1e-12;      // relative
+    int failures = 0;
+
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(6001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+
+    struct Config {
+        int order;
+        std::size_t window;
+        std::size_t step;
+    };
+    // Steps of 1 and 7 slide (and resync every window); 600 > window / 2
+    // recomputes the sums at every origin.
+    const Config configs[] = {{1, 240, 1}, {5, 240, 7}, {20, 1000, 1}, {10, 1000, 600}};
+    for (const Config& c : configs) {
+        WalkForwardOptions options;
+        options.order = c.order;
+        options.window = c.window;
+        options.step = c.step;
+        options.horizon = 20;
+        options.blockOrigins = 64;
+        options.keepForecasts = true;
+
+        WalkForwardBacktester serial(1), parallel(4);
+        WalkForwardResult r = serial.run(SeriesView(x), SeriesView(prices), options);
+        WalkForwardResult rp = parallel.run(SeriesView(x), SeriesView(prices), options);
+        WalkForwardResult rd = serial.run(SeriesView(x), options);
+        bool ok = r.origins > 0 && r.failedFits == 0 && rp.forecasts.size() == r.forecasts.size() &&
+                  std::memcmp(rp.forecasts.data(), r.forecasts.data(), r.forecasts.size() * sizeof(double)) == 0 &&
+                  rp.overall.mse == r.overall.mse && rp.overall.mape == r.overall.mape &&
+                  rd.forecasts.size() == r.forecasts.size();
+        const bool threadOk = ok;
+
+        // Reference: refit the window from scratch and integrate from the
+        // level at the origin.
+        const std::size_t h = options.horizon;
+        double maxDiff = 0.0, scale = 0.0, maxDiffD = 0.0, scaleD = 0.0, sumSq = 0.0;
+        for (std::size_t i = 0; ok && i < r.origins; ++i) {
+            const std::size_t t = c.window + i * c.step;
+            ARModel model(SeriesView(x.data() + t - c.window, c.window), c.order);
+            model.setAutocorrelationMethod(AutocorrelationMethod::Direct);
+            ok = model.computeCoefficients();
+            std::vector<double> f = model.forwardPredictSteps(static_cast<int>(h));
+            double level = prices[t];
+            for (std::size_t j = 0; ok && j < h; ++j) {
+                maxDiffD = std::max(maxDiffD, std::abs(rd.forecasts[i * h + j] - f[j]));
+                scaleD = std::max(scaleD, std::abs(f[j]));
+                level += f[j];
+                double got = r.forecasts[i * h + j];
+                maxDiff = std::max(maxDiff, std::abs(got - level));
+                scale = std::max(scale, std::abs(level));
+                double diff = level - prices[t + j + 1];
+                sumSq += diff * diff;
+            }
+        }
+        double mse = sumSq / (r.origins * h);
+        double forecastDiff = std::max(scale > 0.0 ? maxDiff / scale : 0.0, scaleD > 0.0 ? maxDiffD / scaleD : 0.0);
+        double mseDiff = std::abs(r.overall.mse - mse) / mse;
+        ok = ok && forecastDiff <= kForecastTolerance && mseDiff <= kMseTolerance;
+        failures += ok ? 0 : 1;
+        std::printf("%s  p=%d window=%zu step=%zu, %zu origins: threads %s, max forecast diff %.3g, "
+                    "MSE rel. diff %.3g\n",
+                    ok ? "PASS" : "FAIL", c.order, c.window, c.step, r.origins,
+                    threadOk ? "bitwise equal" : "differ", forecastDiff, mseDiff);
+    }
+    // Origins whose window is all zeros are counted as failed fits, not fitted.
+    // Step 600 recomputes the sums at each origin, so the zero windows are exact.
+    {
+        std::vector<double> z(x);
+        std::fill(z.begin() + 1200, z.begin() + 3000, 0.0);
+        WalkForwardOptions options;
+        options.order = 5;
+        options.window = 600;
+        options.step = 600;
+        options.horizon = 20;
+        options.keepForecasts = true;
+        WalkForwardResult r = WalkForwardBacktester(4).run(SeriesView(z), options);
+        // The origins t = 1800, 2400 and 3000 train inside z[1200, 3000).
+        bool ok = r.origins == 9 && r.failedFits == 3 && std::isnan(r.forecasts[2 * 20]) &&
+                  std::isnan(r.forecasts[4 * 20]) && !std::isnan(r.forecasts[5 * 20]);
+        failures += ok ? 0 : 1;
+        std::printf("%s  all-zero windows: %zu of %zu origins reported as failed fits\n", ok ? "PASS" : "FAIL",
+                    r.failedFits, r.origins);
+    }
+    return failures == 0 ? 0 : 1;
+}
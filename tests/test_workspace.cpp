@@ -0,0 +1,40 @@
+#include "ar_tests.h"
+#include "ARModel.h"
+#include "SyntheticDataGenerator.h"
+#include "Transforms.h"
+#include <cstdio>
+#include <vector>
+
+// Repeated workspace fits/forecasts after warm-up must not touch the heap.
+int testAllocFree() {
+    std::vector<double> prices = SyntheticDataGenerator::generateGBM(20001, 100.0, 0.01, 0.1, 1.0 / 252, 42);
+    std::vector<double> x = Transforms::difference(SeriesView(prices));
+
+    const int maxOrder = 200;
+    ARWorkspace ws(maxOrder, x.size());
+    std::vector<double> out(1000);
+    int failures = 0;
+
+    const AutocorrelationMethod methods[] = {AutocorrelationMethod::Direct, AutocorrelationMethod::FFT};
+    for (AutocorrelationMethod method : methods) {
+        for (int p : {1, 10, 50, maxOrder}) {
+            ARModel model(SeriesView(x), p);
+            model.setAutocorrelationMethod(method);
+            model.computeCoefficients(ws); // warm-up sizes the model's own vectors
+            model.forwardPredictSteps(static_cast<int>(out.size()), out.data(), ws);
+
+            unsigned long long before = g_allocations.load();
+            for (int rep = 0; rep < 20; ++rep) {
+                model.computeCoefficients(ws);
+                model.forwardPredictSteps(static_cast<int>(out.size()), out.data(), ws);
+                g_sink = out.back() + model.forwardPredict();
+            }
+            unsigned long long allocs = g_allocations.load() - before;
+            bool ok = allocs == 0;
+            failures += ok ? 0 : 1;
+            std::printf("%s  %s fit+forecast p=%d: %llu allocations\n", ok ? "PASS" : "FAIL",
+                        method == AutocorrelationMethod::FFT ? "fft   " : "direct", p, allocs);
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}